@@ -48,6 +48,7 @@ class NBodyApp {
         this.ui.setRenderer(this.renderer);
         
         this.bodies = [];
+        this.renderBodies = []; // Reused list of active and archived bodies for drawing
         this.selectedBody = null;
         this.isRunning = false;
         this.isPaused = false;
@@ -61,6 +62,9 @@ class NBodyApp {
         this.dragOffset = new Vector2D(0, 0);
         this.lastMousePos = new Vector2D(0, 0);
         this.dragStartPosition = new Vector2D(0, 0); // Track drag start for orbit preview
+        this.isSpraying = false; // Shift-drag on empty space sprays bodies
+        this.sprayQueue = []; // Sprayed bodies waiting for the next frame's batch insert
+        this.sprayTarget = null; // Body sprayed bodies orbit in orbit mode
         
         // Performance tracking
         this.frameCount = 0;
@@ -70,8 +74,38 @@ class NBodyApp {
         this.useWebWorkers = false;
         this.physicsWorker = null;
         this.workerBusy = false;
+        this.workerSequence = 0; // Id of the step request currently in flight
+        this.workerPendingTime = 0; // Frame time accumulated while the worker was busy
+        this.workerSentIds = null; // Body ids included in the in-flight step request
+        this.workerPostTime = 0; // When the in-flight step request was posted
         this.initialEnergy = null;
         
+        // Per-frame phase timings, with the surrounding frames captured on a stall
+        this.flightRecorder = new FlightRecorder();
+        this.getStallContext = () => this.describeFrameContext();
+        
+        // Benchmark mode: seeded scenes run through a settings matrix, then the user's scene returns
+        this.benchmark = new BenchmarkRunner();
+        this.benchmarkSavedState = null; // Scene and settings to restore afterwards
+        
+        // Memory per subsystem; one over its budget sheds load (trail length, history tiers, caches)
+        this.memoryLedger = new MemoryLedger();
+        this.workerMemory = null; // Last memory report from the physics worker
+        this.workerMemoryRequested = false; // Ask for a report with the next worker step
+        this.trailLengthLimit = Infinity; // Longest trail a new body gets, lowered when the trail budget sheds
+        this.registerMemoryLedger();
+        
+        // Time-sliced background jobs (energy audits, long-term previews, large imports)
+        this.scheduler = new TaskScheduler();
+        this.energyAuditStamp = null; // Simulation time and body count of the last audit
+        this.loadProgress = null; // Fraction of a sliced configuration import, null when idle
+        this.groupCatalog = new GroupCatalog();
+        this.groupFinderEnabled = false;
+        this.groupCatalogStamp = null; // Simulation time and body count of the last catalog request
+        this.orbitSurvey = null; // Last orbital-element survey, with the body ids it covers
+        this.orbitSurveyEnabled = false;
+        this.orbitSurveyStamp = null; // Simulation time and body count of the last survey request
+        
         // Store references for cleanup
         this.eventCleanupFunctions = [];
         this.intervalIds = [];
@@ -89,8 +123,11 @@ class NBodyApp {
         this.eventCleanupFunctions.forEach(cleanup => cleanup());
         this.eventCleanupFunctions = [];
         
+        this.flightRecorder.stop();
+        
         // Clean up web worker
         if (this.physicsWorker) {
+            this.scheduler.setWorker(null);
             this.physicsWorker.terminate();
             this.physicsWorker = null;
         }
@@ -212,13 +249,36 @@ class NBodyApp {
 
     // Main game loop
     startMainLoop() {
+        const recorder = this.flightRecorder;
+        recorder.start();
+        
         const loop = (currentTime) => {
             const deltaTime = currentTime - this.lastFrameTime;
             this.lastFrameTime = currentTime;
+            recorder.beginFrame(performance.now());
             
-            this.update(deltaTime / 1000); // Convert to seconds
+            // A benchmark feeds exactly one physics step of time per frame
+            const frameDelta = this.benchmark.active ? this.physics.fixedTimeStep : deltaTime / 1000;
+            
+            this.updateTrailSampling();
+            this.update(frameDelta);
             this.render();
+            
+            let phaseStart = performance.now();
             this.updatePerformanceMetrics(currentTime);
+            const phaseEnd = performance.now();
+            recorder.add(FRAME_PHASE.UI, phaseEnd - phaseStart);
+            phaseStart = phaseEnd;
+            
+            if (this.benchmark.active) {
+                this.updateBenchmark(currentTime);
+            } else {
+                this.runBackgroundJobs();
+            }
+            const frameEnd = performance.now();
+            recorder.add(FRAME_PHASE.BACKGROUND, frameEnd - phaseStart);
+            recorder.set(FRAME_PHASE.BODIES, this.bodies.length);
+            recorder.endFrame(frameEnd, this.getStallContext);
             
             requestAnimationFrame(loop);
         };
@@ -226,10 +286,576 @@ class NBodyApp {
         requestAnimationFrame(loop);
     }
 
+    // What a stall capture records about the simulation besides the frame timings
+    describeFrameContext() {
+        const renderStats = this.renderer.getStats();
+        return {
+            bodyCount: this.bodies.length,
+            archivedBodies: this.physics.escapers.getArchivedBodies().length,
+            running: this.isRunning && !this.isPaused,
+            useWebWorkers: this.useWebWorkers,
+            useGPU: this.useGPU,
+            physics: this.physics.getConfiguration(),
+            rendering: {
+                mode: renderStats.activeMode,
+                renderScale: renderStats.renderScale,
+                showTrails: this.renderer.showTrails,
+                canvas: { width: this.canvas.width, height: this.canvas.height }
+            },
+            memory: this.memoryLedger.getStats()
+        };
+    }
+
+    // Physics phases of one update, from this thread or from a worker result
+    recordPhysicsTimings(physicsTime, frameTimings) {
+        const recorder = this.flightRecorder;
+        recorder.add(FRAME_PHASE.PHYSICS, physicsTime);
+        if (frameTimings) {
+            recorder.add(FRAME_PHASE.STEPS, frameTimings.steps);
+            recorder.add(FRAME_PHASE.TREE_BUILD, frameTimings.treeBuild);
+            recorder.add(FRAME_PHASE.TREE_WALK, frameTimings.treeWalk);
+            recorder.add(FRAME_PHASE.COLLISIONS, frameTimings.collisions);
+        }
+    }
+
+    // Subsystems tracked by the memory ledger. Only the ones that can give memory back
+    // have budgets; the rest are reported so that growth anywhere shows up.
+    registerMemoryLedger() {
+        const ledger = this.memoryLedger;
+        const budgets = RENDERING_CONSTANTS.MEMORY_BUDGETS;
+        const objectBytes = RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES;
+        const none = { bytes: 0, objects: 0 };
+        
+        ledger.register('bodies', {
+            label: 'Bodies',
+            measure: () => {
+                const objects = this.getRenderBodies().length * RENDERING_CONSTANTS.MEMORY_BODY_OBJECTS;
+                return { bytes: objects * objectBytes, objects };
+            }
+        });
+        ledger.register('trails', {
+            label: 'Trails',
+            budget: budgets.trails,
+            measure: () => {
+                let points = 0;
+                for (const body of this.getRenderBodies()) points += body.trail.length;
+                // One Vector2D per point plus its array slot
+                return { bytes: points * (objectBytes + 8), objects: points };
+            },
+            shed: () => this.shedTrails()
+        });
+        ledger.register('trailHistory', {
+            label: 'Trail history',
+            budget: budgets.trailHistory,
+            measure: () => {
+                let bytes = 0;
+                let objects = 0;
+                for (const body of this.getRenderBodies()) {
+                    if (!body.trailHistory) continue;
+                    bytes += body.trailHistory.getByteLength();
+                    objects += 1 + body.trailHistory.tiers.length;
+                }
+                return { bytes: bytes + objects * objectBytes, objects };
+            },
+            shed: () => this.shedTrailHistory()
+        });
+        ledger.register('energyHistory', {
+            label: 'Energy history',
+            budget: budgets.energyHistory,
+            measure: () => {
+                const objects = this.physics.energyHistory.length;
+                return { bytes: objects * objectBytes, objects };
+            },
+            shed: () => {
+                const minimum = RENDERING_CONSTANTS.MEMORY_MIN_ENERGY_HISTORY;
+                if (this.physics.maxEnergyHistory <= minimum) return false;
+                this.physics.setEnergyHistoryLimit(Math.max(minimum, this.physics.maxEnergyHistory * RENDERING_CONSTANTS.MEMORY_SHED_FACTOR));
+                return true;
+            }
+        });
+        ledger.register('physics', {
+            label: 'Physics buffers',
+            measure: () => this.physics.getMemoryUsage()
+        });
+        ledger.register('worker', {
+            label: 'Worker',
+            measure: () => {
+                // The report arrives with a later step, so the worker figures lag one check
+                if (!this.physicsWorker) return none;
+                this.workerMemoryRequested = true;
+                return this.workerMemory || none;
+            }
+        });
+        ledger.register('renderCaches', {
+            label: 'Render caches',
+            budget: budgets.renderCaches,
+            measure: () => {
+                const usage = this.renderer.getMemoryUsage();
+                return usage ? usage.caches : none;
+            },
+            shed: () => this.renderer.shrinkCaches()
+        });
+        ledger.register('canvasLayers', {
+            label: 'Canvas layers',
+            measure: () => {
+                const usage = this.renderer.getMemoryUsage();
+                return usage ? usage.layers : none;
+            }
+        });
+        ledger.register('orbits', {
+            label: 'Orbit previews',
+            measure: () => {
+                const usage = this.renderer.getMemoryUsage();
+                const previews = usage ? usage.previews : none;
+                const survey = this.orbitSurvey ? MemoryLedger.typedArrayBytes([this.orbitSurvey]) : 0;
+                return { bytes: previews.bytes + survey, objects: previews.objects };
+            }
+        });
+        ledger.register('flightRecorder', {
+            label: 'Flight recorder',
+            budget: budgets.flightRecorder,
+            measure: () => this.flightRecorder.getMemoryUsage(),
+            shed: () => this.flightRecorder.shedCaptures()
+        });
+        ledger.register('kernelCache', {
+            label: 'Force kernels',
+            budget: budgets.kernelCache,
+            measure: () => this.physics.kernelGenerator.getMemoryUsage(),
+            shed: () => {
+                // The active kernel recompiles on the next force pass
+                if (this.physics.kernelGenerator.cache.size <= 1) return false;
+                this.physics.kernelGenerator.clearCache();
+                return true;
+            }
+        });
+        ledger.register('escaperArchive', {
+            label: 'Escaper archive',
+            measure: () => this.physics.escapers.getMemoryUsage()
+        });
+        ledger.register('groupCatalog', {
+            label: 'Group catalog',
+            measure: () => this.groupCatalog ? this.groupCatalog.getMemoryUsage() : none
+        });
+    }
+
+    // Trail budget exceeded: shorten every trail longer than the minimum, and the trails
+    // new bodies get. The worker picks the new lengths up with the next step.
+    shedTrails() {
+        const minimum = RENDERING_CONSTANTS.MEMORY_MIN_TRAIL_LENGTH;
+        const factor = RENDERING_CONSTANTS.MEMORY_SHED_FACTOR;
+        let shortened = false;
+        for (const body of this.getRenderBodies()) {
+            if (body.maxTrailLength <= minimum) continue;
+            body.trimTrail(Math.max(minimum, body.maxTrailLength * factor));
+            shortened = true;
+        }
+        
+        const defaultLength = this.getNewTrailLength(this.ui.getSliderValue('trail-length'));
+        if (defaultLength > minimum) {
+            this.trailLengthLimit = Math.max(minimum, Math.floor(defaultLength * factor));
+            shortened = true;
+        }
+        this.ui.updateSlider('trail-length', this.selectedBody ? this.selectedBody.maxTrailLength : this.trailLengthLimit);
+        return shortened;
+    }
+
+    // Trail length for a new body, within whatever the trail budget has shed to
+    getNewTrailLength(length) {
+        return Math.min(Math.round(length), this.trailLengthLimit);
+    }
+
+    // Trail history budget exceeded: drop the coarsest tier, for new histories too
+    shedTrailHistory() {
+        if (Body.trailHistoryTiers <= 1) return false;
+        Body.trailHistoryTiers--;
+        for (const body of this.getRenderBodies()) {
+            while (body.trailHistory && body.trailHistory.tiers.length > Body.trailHistoryTiers) {
+                body.trailHistory.dropOldestTier();
+            }
+        }
+        return true;
+    }
+
+    // Benchmark button: start, or cancel a benchmark in progress
+    toggleBenchmark() {
+        if (this.benchmark.active) {
+            this.finishBenchmark(true);
+            return;
+        }
+        if (this.loadProgress !== null) {
+            this.ui.showNotification('Wait for the configuration import to finish', 'warning');
+            return;
+        }
+        
+        const camera = this.renderer.camera;
+        this.benchmarkSavedState = {
+            bodies: this.bodies,
+            escapers: this.physics.escapers.serialize(this.physics.simulationTime),
+            physics: this.physics.getConfiguration(),
+            useGPU: this.useGPU,
+            useWebWorkers: this.useWebWorkers,
+            renderingMode: this.renderer.renderingMode,
+            camera: { x: camera.x, y: camera.y, zoom: camera.zoom },
+            isRunning: this.isRunning,
+            isPaused: this.isPaused
+        };
+        
+        // GPU physics is not part of the matrix; every run steps on the CPU
+        this.useGPU = false;
+        this.physics.setConfiguration({ useGPUPhysics: false, timeScale: 1, adaptiveTimeStep: false });
+        this.resetGroupCatalog();
+        this.resetOrbitSurvey();
+        this.selectedBody = null;
+        
+        const plan = BenchmarkRunner.createPlan({
+            webgl: this.renderer.webglSupported,
+            workers: typeof Worker !== 'undefined'
+        });
+        this.benchmark.begin(plan, this.describeBenchmarkEnvironment());
+        this.startNextBenchmarkRun();
+        this.ui.showNotification(`Benchmark started: ${plan.length} runs`, 'info');
+    }
+
+    describeBenchmarkEnvironment() {
+        return {
+            userAgent: navigator.userAgent,
+            hardwareConcurrency: navigator.hardwareConcurrency || null,
+            deviceMemory: navigator.deviceMemory || null,
+            devicePixelRatio: window.devicePixelRatio,
+            canvasWidth: this.canvas.width,
+            canvasHeight: this.canvas.height,
+            webglSupported: this.renderer.webglSupported,
+            physics: this.physics.getConfiguration(),
+            rendering: {
+                showTrails: this.renderer.showTrails,
+                trailMode: this.renderer.currentRenderer ? this.renderer.currentRenderer.trailMode : null,
+                dynamicResolution: this.renderer.resolutionScaler.enabled
+            }
+        };
+    }
+
+    // Put the next run's scene and settings in place
+    startNextBenchmarkRun() {
+        const run = this.benchmark.nextRun();
+        
+        this.bodies = BenchmarkRunner.createScene(run);
+        this.physics.setForceFields(Presets.getForceFields(run.scene));
+        this.physics.escapers.clear();
+        this.physics.setConfiguration({ forceCalculationMethod: run.forceMethod });
+        this.setWebWorkersEnabled(run.workers);
+        this.discardWorkerStep();
+        this.resetEnergyTracking();
+        this.renderer.setRenderingMode(run.renderer);
+        this.renderer.fitAllBodies(this.bodies);
+        this.isRunning = true;
+        this.isPaused = false;
+        
+        const energy = BenchmarkRunner.measureEnergy(this.bodies, this.physics.gravitationalConstant, this.physics.softeningParameter);
+        this.benchmark.startRun(performance.now(), this.physics.fixedTimeStep, energy);
+        this.ui.updateBenchmark(this.benchmark.getStatus());
+    }
+
+    // Feed the frame's timings to the current run and move on when it is over
+    updateBenchmark(currentTime) {
+        const recorder = this.flightRecorder;
+        const runner = this.benchmark;
+        const done = runner.recordFrame(
+            currentTime,
+            recorder.get(FRAME_PHASE.PHYSICS),
+            recorder.get(FRAME_PHASE.STEPS),
+            recorder.get(FRAME_PHASE.RENDER)
+        );
+        if (!done) return;
+        
+        const energy = BenchmarkRunner.measureEnergy(this.bodies, this.physics.gravitationalConstant, this.physics.softeningParameter);
+        runner.finishRun(performance.now(), energy, {
+            activeRenderer: this.renderer.activeMode,
+            workerStepping: Boolean(this.isWorkerStepping()) // False if the worker was dropped after timeouts
+        });
+        
+        if (runner.hasNextRun()) {
+            this.startNextBenchmarkRun();
+        } else {
+            this.finishBenchmark(false);
+        }
+    }
+
+    // Restore the user's scene and settings
+    finishBenchmark(cancelled) {
+        const report = this.benchmark.finish(cancelled);
+        const saved = this.benchmarkSavedState;
+        this.benchmarkSavedState = null;
+        
+        this.bodies = saved.bodies;
+        this.discardWorkerStep();
+        this.physics.setConfiguration(saved.physics);
+        this.physics.escapers.load(saved.escapers, this.physics.simulationTime);
+        this.resetEnergyTracking();
+        this.useGPU = saved.useGPU;
+        this.physics.setConfiguration({ useGPUPhysics: saved.useGPU });
+        this.setWebWorkersEnabled(saved.useWebWorkers);
+        this.renderer.setRenderingMode(saved.renderingMode);
+        const camera = this.renderer.camera;
+        camera.x = saved.camera.x;
+        camera.y = saved.camera.y;
+        camera.zoom = saved.camera.zoom;
+        camera.targetZoom = saved.camera.zoom;
+        this.isRunning = saved.isRunning;
+        this.isPaused = saved.isPaused;
+        
+        this.ui.updateBenchmark(this.benchmark.getStatus());
+        this.ui.showNotification(cancelled
+            ? `Benchmark cancelled after ${report.runs.length} runs`
+            : `Benchmark finished: ${report.runs.length} runs`, cancelled ? 'warning' : 'success');
+    }
+
+    downloadBenchmarkReport(format) {
+        const report = this.benchmark.report;
+        if (!report) {
+            this.ui.showNotification('Run the benchmark first', 'info');
+            return;
+        }
+        
+        const stamp = report.time.replace(/[:.]/g, '-');
+        if (format === 'html') {
+            this.ui.downloadFile(`celestialsim-benchmark-${stamp}.html`, BenchmarkRunner.toHTML(report), 'text/html');
+        } else {
+            this.ui.downloadFile(`celestialsim-benchmark-${stamp}.json`, JSON.stringify(report, null, 2));
+        }
+    }
+
+    downloadFlightRecording() {
+        const dump = this.flightRecorder.getDump(this.describeFrameContext());
+        const filename = `celestialsim-frames-${new Date().toISOString().replace(/[:.]/g, '-')}.json`;
+        this.ui.downloadFile(filename, JSON.stringify(dump));
+        
+        const captures = dump.captures.length;
+        this.ui.showNotification(captures > 0 ? `Frame recording saved (${captures} stalls captured)` : 'Frame recording saved', 'success');
+    }
+
     // This update method is replaced by the enhanced version below with Web Worker support
 
+    // Trail points are spaced a few screen pixels apart at the current zoom, unless a fixed
+    // world spacing is configured
+    updateTrailSampling() {
+        const worldDistance = RENDERING_CONSTANTS.TRAIL_SAMPLE_WORLD_DISTANCE;
+        Body.trailSampleDistance = worldDistance > 0 ? worldDistance :
+            RENDERING_CONSTANTS.TRAIL_SAMPLE_PIXELS / this.renderer.getCameraZoom();
+    }
+
+    // Spend what is left of the frame budget on scheduled jobs
+    runBackgroundJobs() {
+        this.updateEnergyAudit();
+        this.updateGroupCatalog();
+        this.updateOrbitSurvey();
+        this.scheduler.run();
+    }
+
+    // Request a friends-of-friends catalog every GROUP_CATALOG_INTERVAL physics steps.
+    // The job runs in the physics worker when there is one.
+    updateGroupCatalog() {
+        const n = this.bodies.length;
+        if (!this.groupFinderEnabled || n < PHYSICS_CONSTANTS.GROUP_MIN_MEMBERS ||
+            this.scheduler.hasPendingTasks('group-catalog')) {
+            return;
+        }
+        
+        const simulationTime = this.physics.simulationTime;
+        const stamp = this.groupCatalogStamp;
+        const interval = PHYSICS_CONSTANTS.GROUP_CATALOG_INTERVAL * this.physics.fixedTimeStep;
+        if (stamp && stamp.bodyCount === n && Math.abs(simulationTime - stamp.simulationTime) < interval) {
+            return;
+        }
+        this.groupCatalogStamp = { simulationTime, bodyCount: n };
+        
+        const x = new Float64Array(n);
+        const y = new Float64Array(n);
+        const vx = new Float64Array(n);
+        const vy = new Float64Array(n);
+        const mass = new Float64Array(n);
+        const ids = new Float64Array(n);
+        for (let i = 0; i < n; i++) {
+            const body = this.bodies[i];
+            x[i] = body.position.x;
+            y[i] = body.position.y;
+            vx[i] = body.velocity.x;
+            vy[i] = body.velocity.y;
+            mass[i] = body.mass;
+            ids[i] = body.id;
+        }
+        
+        this.scheduler.schedule({
+            type: 'group-catalog',
+            payload: {
+                x, y, vx, vy, mass, ids,
+                linkingLength: 0,
+                linkingFactor: PHYSICS_CONSTANTS.GROUP_LINKING_FACTOR,
+                minMembers: PHYSICS_CONSTANTS.GROUP_MIN_MEMBERS,
+                unbind: true,
+                gravitationalConstant: this.physics.gravitationalConstant,
+                softeningParameter: this.physics.softeningParameter
+            }
+        }, {
+            key: 'group-catalog',
+            priority: TASK_PRIORITY.LOW,
+            onComplete: result => {
+                this.groupCatalog.update(result, simulationTime);
+                this.renderer.setGroupCatalog(this.groupCatalog.groups);
+                this.ui.updateGroupCatalog(this.groupCatalog, this.groupFinderEnabled);
+            }
+        });
+    }
+
+    setGroupFinderEnabled(enabled) {
+        this.groupFinderEnabled = enabled;
+        if (!enabled) {
+            this.resetGroupCatalog();
+        }
+    }
+
+    resetGroupCatalog() {
+        this.scheduler.cancelKey('group-catalog');
+        this.groupCatalog.clear();
+        this.groupCatalogStamp = null;
+        this.renderer.setGroupCatalog(null);
+        this.ui.updateGroupCatalog(this.groupCatalog, this.groupFinderEnabled);
+    }
+
+    // Request orbital elements for every body each ORBIT_SURVEY_INTERVAL physics steps,
+    // also in the physics worker when there is one
+    updateOrbitSurvey() {
+        const n = this.bodies.length;
+        if (!this.orbitSurveyEnabled || n < 2 || this.scheduler.hasPendingTasks('orbital-elements')) {
+            return;
+        }
+        
+        const simulationTime = this.physics.simulationTime;
+        const stamp = this.orbitSurveyStamp;
+        const interval = PHYSICS_CONSTANTS.ORBIT_SURVEY_INTERVAL * this.physics.fixedTimeStep;
+        if (stamp && stamp.bodyCount === n && Math.abs(simulationTime - stamp.simulationTime) < interval) {
+            return;
+        }
+        this.orbitSurveyStamp = { simulationTime, bodyCount: n };
+        
+        const x = new Float64Array(n);
+        const y = new Float64Array(n);
+        const vx = new Float64Array(n);
+        const vy = new Float64Array(n);
+        const mass = new Float64Array(n);
+        const ids = new Float64Array(n);
+        for (let i = 0; i < n; i++) {
+            const body = this.bodies[i];
+            x[i] = body.position.x;
+            y[i] = body.position.y;
+            vx[i] = body.velocity.x;
+            vy[i] = body.velocity.y;
+            mass[i] = body.mass;
+            ids[i] = body.id;
+        }
+        
+        this.scheduler.schedule({
+            type: 'orbital-elements',
+            payload: {
+                x, y, vx, vy, mass,
+                gravitationalConstant: this.physics.gravitationalConstant,
+                bins: PHYSICS_CONSTANTS.ORBIT_HISTOGRAM_BINS
+            }
+        }, {
+            key: 'orbital-elements',
+            priority: TASK_PRIORITY.LOW,
+            onComplete: result => {
+                this.orbitSurvey = { ...result, ids, simulationTime };
+                this.ui.updateOrbitSurvey(this.orbitSurvey, this.orbitSurveyEnabled, this.selectedBody);
+            }
+        });
+    }
+
+    setOrbitSurveyEnabled(enabled) {
+        this.orbitSurveyEnabled = enabled;
+        if (!enabled) {
+            this.resetOrbitSurvey();
+        }
+    }
+
+    resetOrbitSurvey() {
+        this.scheduler.cancelKey('orbital-elements');
+        this.orbitSurvey = null;
+        this.orbitSurveyStamp = null;
+        this.ui.updateOrbitSurvey(null, this.orbitSurveyEnabled, this.selectedBody);
+    }
+
+    // Large scenes skip the O(N²) potential-energy sum in the main-thread step; a
+    // low-priority audit job supplies it instead and is restarted once it finishes
+    updateEnergyAudit() {
+        const deferred = this.bodies.length > PHYSICS_CONSTANTS.DEFERRED_ENERGY_BODY_THRESHOLD;
+        this.physics.deferPotentialEnergy = deferred;
+        
+        // The worker audits its own copy while it owns the simulation
+        if (!deferred || this.isWorkerStepping() || this.scheduler.hasPendingTasks('energy-audit')) {
+            return;
+        }
+        
+        // Nothing moved since the last audit (e.g. paused)
+        const stamp = this.energyAuditStamp;
+        if (stamp && stamp.simulationTime === this.physics.simulationTime && stamp.bodyCount === this.bodies.length) {
+            return;
+        }
+        this.energyAuditStamp = { simulationTime: this.physics.simulationTime, bodyCount: this.bodies.length };
+        const generation = this.physics.energyGeneration;
+        
+        const n = this.bodies.length;
+        const x = new Float64Array(n);
+        const y = new Float64Array(n);
+        const mass = new Float64Array(n);
+        for (let i = 0; i < n; i++) {
+            x[i] = this.bodies[i].position.x;
+            y[i] = this.bodies[i].position.y;
+            mass[i] = this.bodies[i].mass;
+        }
+        
+        this.scheduler.schedule({
+            type: 'energy-audit',
+            payload: {
+                x, y, mass,
+                gravitationalConstant: this.physics.gravitationalConstant,
+                softeningParameter: this.physics.softeningParameter
+            }
+        }, {
+            key: 'energy-audit',
+            priority: TASK_PRIORITY.LOW,
+            onComplete: result => {
+                // Bodies added since the snapshot leave it short, even within one scene
+                if (result.bodyCount === this.bodies.length) {
+                    this.physics.setDeferredPotentialEnergy(result.potentialEnergy, this.bodies, generation);
+                }
+            }
+        });
+    }
+
+    // Scene change: drop the old scene's audited potential, pending audit and energy baseline
+    resetEnergyTracking() {
+        this.scheduler.cancelKey('energy-audit');
+        this.energyAuditStamp = null;
+        this.physics.resetEnergyTracking();
+        this.initialEnergy = null;
+    }
+
+    isWorkerStepping() {
+        return this.useWebWorkers && this.physicsWorker && this.bodies.length > 8;
+    }
+
     render() {
-        const renderStats = this.renderer.render(this.bodies, this.physics, this.selectedBody);
+        const renderStart = performance.now();
+        const renderStats = this.renderer.render(this.getRenderBodies(), this.physics, this.selectedBody);
+        const renderEnd = performance.now();
+        
+        const recorder = this.flightRecorder;
+        recorder.add(FRAME_PHASE.RENDER, renderEnd - renderStart);
+        if (renderStats && renderStats.passTimes) {
+            recorder.add(FRAME_PHASE.RENDER_TRAILS, renderStats.passTimes.trails);
+            recorder.add(FRAME_PHASE.RENDER_BODIES, renderStats.passTimes.bodies);
+            recorder.add(FRAME_PHASE.RENDER_OVERLAY, renderStats.passTimes.overlay);
+        }
         
         // Update rendering performance display
         if (renderStats) {
@@ -238,6 +864,19 @@ class NBodyApp {
         
         // Update body count display
         this.ui.updateBodyCount(this.bodies.length);
+        recorder.add(FRAME_PHASE.UI, performance.now() - renderEnd);
+    }
+
+    // Active bodies plus any archived escapers, which are still drawn on their analytic paths
+    getRenderBodies() {
+        const archived = this.physics.escapers.getArchivedBodies();
+        if (archived.length === 0) return this.bodies;
+        
+        const renderBodies = this.renderBodies;
+        renderBodies.length = 0;
+        for (let i = 0; i < this.bodies.length; i++) renderBodies.push(this.bodies[i]);
+        for (let i = 0; i < archived.length; i++) renderBodies.push(archived[i]);
+        return renderBodies;
     }
 
     updatePerformanceMetrics(currentTime) {
@@ -253,6 +892,15 @@ class NBodyApp {
             const performanceStats = this.physics.getPerformanceStats();
             performanceStats.fps = this.currentFPS;
             performanceStats.bodyCount = this.bodies.length;
+            performanceStats.diagnostics = Diagnostics.flush(currentTime);
+            performanceStats.groups = this.groupCatalog.getStats();
+            performanceStats.flightRecorder = this.flightRecorder.getStats();
+            this.memoryLedger.update(currentTime);
+            performanceStats.memory = this.memoryLedger.getStats();
+            performanceStats.costProfile = this.physics.costProfile.enabled ? this.physics.costProfile.getHistogram() : null;
+            performanceStats.orbits = this.orbitSurvey
+                ? { bodies: this.orbitSurvey.ids.length, bound: this.orbitSurvey.boundCount, elapsed: this.orbitSurvey.elapsed }
+                : null;
             
             // Add GPU status to performance stats
             if (this.useGPU && this.physics.gpuPhysics && this.physics.gpuPhysics.isReady()) {
@@ -284,7 +932,7 @@ class NBodyApp {
             
             // Update energy display
             const energyStats = this.physics.getEnergyStats();
-            if (this.initialEnergy === null && energyStats.total !== 0) {
+            if (this.initialEnergy === null && energyStats.potentialKnown && energyStats.total !== 0) {
                 this.initialEnergy = energyStats.total;
             }
             energyStats.initial = this.initialEnergy;
@@ -295,11 +943,14 @@ class NBodyApp {
 
     updateUI() {
         // Update simulation status
-        const status = this.isRunning ? (this.isPaused ? 'Paused' : 'Running') : 'Stopped';
+        let status = this.isRunning ? (this.isPaused ? 'Paused' : 'Running') : 'Stopped';
+        if (this.loadProgress !== null) {
+            status = `Loading ${Math.round(this.loadProgress * 100)}%`;
+        }
         this.ui.updateStatus(status);
         
         // Update info panel
-        const stats = this.physics.getSystemStats(this.bodies);
+        const stats = this.getInfoPanelStats();
         this.ui.updateInfoPanel({
             bodyCount: this.bodies.length,
             totalMass: stats.totalMass,
@@ -312,6 +963,9 @@ class NBodyApp {
         
         // Update selected body panel
         this.ui.updateSelectedBodyPanel(this.selectedBody);
+        if (this.orbitSurveyEnabled) {
+            this.ui.updateOrbitSurvey(this.orbitSurvey, true, this.selectedBody);
+        }
         
         // Update play/pause button
         this.ui.updatePlayPauseButton(this.isRunning, this.isPaused);
@@ -320,6 +974,28 @@ class NBodyApp {
         this.updateDynamicReference();
     }
 
+    // Mass and energies for the info panel. Small scenes are summed exactly; large ones reuse
+    // the potential energy kept by the engine, the worker or the background audit.
+    getInfoPanelStats() {
+        if (this.bodies.length <= PHYSICS_CONSTANTS.DEFERRED_ENERGY_BODY_THRESHOLD) {
+            return this.physics.getSystemStats(this.bodies);
+        }
+        
+        let totalMass = 0;
+        let kineticEnergy = 0;
+        for (const body of this.bodies) {
+            totalMass += body.mass;
+            kineticEnergy += 0.5 * body.mass * body.velocity.magnitudeSquared();
+        }
+        
+        return {
+            totalMass,
+            kineticEnergy,
+            potentialEnergy: this.physics.totalPotentialEnergy,
+            totalEnergy: kineticEnergy + this.physics.totalPotentialEnergy
+        };
+    }
+
     // Event handlers
     onMouseDown(event) {
         this.debugMousePosition(event);
@@ -354,6 +1030,12 @@ class NBodyApp {
                 } else {
                     this.wasPausedForDrag = true;
                 }
+            } else if (event.shiftKey) {
+                // Shift-drag on empty space: spray bodies, inserted once per frame
+                this.isSpraying = true;
+                this.sprayTarget = this.ui.isOrbitMode() ? this.findNearestBody(worldPos) : null;
+                this.queueSprayBodies(worldPos);
+                this.selectedBody = null;
             } else {
                 // Click on empty space: add new body or clear selection
                 if (this.ui.isOrbitMode() && this.bodies.length > 0) {
@@ -387,6 +1069,7 @@ class NBodyApp {
             // Update dragged body position
             const newPosition = worldPos.subtract(this.dragOffset);
             this.draggedBody.setPosition(newPosition);
+            this.physics.invalidateCachedAccelerations();
             
             // Update UI sliders to reflect new position if this is the selected body
             if (this.draggedBody === this.selectedBody) {
@@ -399,6 +1082,9 @@ class NBodyApp {
                 this.updateOrbitPreviewForDraggedBody();
             }
             
+        } else if (this.isSpraying) {
+            this.queueSprayBodies(worldPos);
+            
         } else if (event.buttons === 4 || (event.buttons === 1 && event.ctrlKey)) {
             // Middle mouse or Ctrl+left mouse: pan camera
             const deltaX = mousePos.x - this.lastMousePos.x;
@@ -416,7 +1102,11 @@ class NBodyApp {
     }
 
     onMouseUp(event) {
-        if (this.isDragging && this.draggedBody) {
+        if (this.isSpraying) {
+            this.isSpraying = false;
+            this.sprayTarget = null;
+            this.flushSprayQueue();
+        } else if (this.isDragging && this.draggedBody) {
             // Finished dragging a body
             this.isDragging = false;
             
@@ -437,7 +1127,7 @@ class NBodyApp {
             
             // Clear orbit preview
             this.renderer.setOrbitPreview(false);
-            this.renderer.setLongTermPreview(false);
+            this.clearLongTermPreview();
             
         } else if (this.isAddingBody && event.button === 0) {
             // Finished adding a new body
@@ -568,6 +1258,18 @@ class NBodyApp {
             case 'delete-selected':
                 this.deleteSelectedBody();
                 break;
+            case 'download-flight-recording':
+                this.downloadFlightRecording();
+                break;
+            case 'run-benchmark':
+                this.toggleBenchmark();
+                break;
+            case 'download-benchmark-json':
+                this.downloadBenchmarkReport('json');
+                break;
+            case 'download-benchmark-html':
+                this.downloadBenchmarkReport('html');
+                break;
         }
     }
 
@@ -579,6 +1281,15 @@ class NBodyApp {
             case 'show-trails':
                 this.renderer.setShowTrails(checked);
                 break;
+            case 'accumulated-trails':
+                this.renderer.setTrailMode(checked ? 'accumulation' : 'polyline');
+                break;
+            case 'trail-history':
+                Body.keepTrailHistory = checked;
+                if (!checked) {
+                    this.getRenderBodies().forEach(body => { body.trailHistory = null; });
+                }
+                break;
             case 'show-grid':
                 this.renderer.setShowGrid(checked);
                 break;
@@ -598,6 +1309,26 @@ class NBodyApp {
             case 'adaptive-timestep':
                 this.physics.setConfiguration({ adaptiveTimeStep: checked });
                 break;
+            case 'multiple-time-stepping':
+                this.physics.setConfiguration({ multipleTimeStepping: checked });
+                break;
+            case 'escaper-archival':
+                this.physics.setConfiguration({ escaperArchival: checked });
+                break;
+            case 'memory-budgets':
+                this.memoryLedger.setEnforcing(checked);
+                if (!checked) this.trailLengthLimit = Infinity;
+                break;
+            case 'cost-overlay':
+                this.physics.setConfiguration({ costProfiling: checked });
+                this.renderer.setCostOverlay(checked);
+                break;
+            case 'group-finder':
+                this.setGroupFinderEnabled(checked);
+                break;
+            case 'orbit-survey':
+                this.setOrbitSurveyEnabled(checked);
+                break;
             case 'web-workers':
                 this.setWebWorkersEnabled(checked);
                 break;
@@ -625,8 +1356,11 @@ class NBodyApp {
             reader.onload = (e) => {
                 try {
                     const config = JSON.parse(e.target.result);
-                    this.loadConfiguration(config);
-                    this.ui.showNotification('Configuration loaded successfully!', 'success');
+                    if (this.loadConfiguration(config)) {
+                        this.ui.showNotification('Configuration loaded successfully!', 'success');
+                    } else {
+                        this.ui.showNotification(`Loading ${config.bodies.length} bodies...`, 'info');
+                    }
                 } catch (error) {
                     this.ui.showNotification('Error loading configuration: ' + error.message, 'error');
                 }
@@ -701,7 +1435,7 @@ class NBodyApp {
         
         // Clear orbit previews when simulation starts
         this.renderer.setOrbitPreview(false);
-        this.renderer.setLongTermPreview(false);
+        this.clearLongTermPreview();
     }
 
     pauseSimulation() {
@@ -720,20 +1454,27 @@ class NBodyApp {
         
         // Clear orbit previews
         this.renderer.setOrbitPreview(false);
-        this.renderer.setLongTermPreview(false);
+        this.clearLongTermPreview();
         
         this.ui.showNotification('Simulation reset', 'info');
     }
 
     clearAll() {
+        this.scheduler.cancelKey('load-configuration');
         this.bodies = [];
+        this.physics.setForceFields([]);
+        this.physics.escapers.clear();
+        this.resetGroupCatalog();
+        this.resetOrbitSurvey();
+        this.resetEnergyTracking();
         this.selectedBody = null;
+        this.discardWorkerStep();
         this.isRunning = false;
         this.isPaused = false;
         
         // Clear orbit previews
         this.renderer.setOrbitPreview(false);
-        this.renderer.setLongTermPreview(false);
+        this.clearLongTermPreview();
         
         this.updateDynamicReference(); // Update reference panel after clearing
         this.ui.showNotification('All bodies cleared', 'info');
@@ -745,7 +1486,7 @@ class NBodyApp {
         // Ensure mass is never zero or negative
         mass = Math.max(0.1, mass || 50); // Default to 50 if invalid
         
-        const trailLength = this.ui.getSliderValue('trail-length');
+        const trailLength = this.getNewTrailLength(this.ui.getSliderValue('trail-length'));
         const color = this.ui.getSelectedColor();
         
         let velocity = new Vector2D(0, 0);
@@ -773,19 +1514,11 @@ class NBodyApp {
             velocity,
             mass,
             color,
-            Math.round(trailLength)
+            trailLength
         );
         
-        this.bodies.push(body);
-        
-        // IMPORTANT: Calculate initial forces for the new body immediately if simulation is running
-        // This ensures the body participates in physics from the first frame
-        if (this.isRunning && !this.isPaused) {
-            // Use setTimeout to ensure the body is fully added to the array first
-            setTimeout(() => {
-                this.calculateInitialForcesForBody(body);
-            }, 0);
-        }
+        // Inserting also computes the body's initial force, so it participates from the first frame
+        this.physics.insertBodies(this.bodies, [body]);
         
         this.selectBody(body, true); // Pass flag to indicate this is a new body
         
@@ -806,28 +1539,56 @@ class NBodyApp {
         }
     }
 
-    // Calculate initial forces for a newly added body
-    calculateInitialForcesForBody(newBody) {
-        // Reset the new body's force
-        newBody.resetForce();
-        
-        // Calculate forces between the new body and all existing bodies
-        for (const existingBody of this.bodies) {
-            if (existingBody === newBody) continue; // Skip self
-            
-            // Calculate force between new body and existing body
-            const force = newBody.calculateGravitationalForce(
-                existingBody, 
-                this.physics.gravitationalConstant, 
-                this.physics.softeningParameter
-            );
+    // Add many bodies at once: one insertion pass, one initial-force pass and one UI
+    // update. Each spec is a Body or { position, velocity, mass, color, trailLength }.
+    addBodies(specs, options = {}) {
+        const trailLength = this.ui.getSliderValue('trail-length');
+        const newBodies = specs.map(spec => spec instanceof Body ? spec : new Body(
+            spec.position,
+            spec.velocity || new Vector2D(0, 0),
+            spec.mass,
+            spec.color || this.ui.getSelectedColor(),
+            this.getNewTrailLength(spec.trailLength !== undefined ? spec.trailLength : trailLength)
+        ));
+        
+        this.physics.insertBodies(this.bodies, newBodies);
+        
+        if (options.updateUI !== false) {
+            this.updateUI();
+        }
+        if (options.notify !== false && newBodies.length > 0) {
+            this.ui.showNotification(`Added ${newBodies.length} bodies`, 'success');
+        }
+        return newBodies;
+    }
+
+    // Queue a handful of bodies scattered around the cursor for the next batch insert
+    queueSprayBodies(worldPos) {
+        const mass = Math.max(0.1, (this.ui.getSliderValue('body-mass') || 50) * UI_CONSTANTS.SPRAY_MASS_FRACTION);
+        const color = this.ui.getSelectedColor();
+        const radius = UI_CONSTANTS.SPRAY_RADIUS / this.renderer.camera.zoom;
+        const manualVelocity = new Vector2D(this.ui.getSliderValue('velocity-x'), this.ui.getSliderValue('velocity-y'));
+        
+        for (let k = 0; k < UI_CONSTANTS.SPRAY_BODIES_PER_MOVE; k++) {
+            // Uniform over the disc around the cursor
+            const angle = Math.random() * Math.PI * 2;
+            const distance = radius * Math.sqrt(Math.random());
+            const position = new Vector2D(worldPos.x + Math.cos(angle) * distance, worldPos.y + Math.sin(angle) * distance);
             
-            // Apply force to new body only
-            // The regular physics will handle the reciprocal forces in the next step
-            newBody.applyForce(force);
+            const velocity = this.sprayTarget
+                ? this.ui.calculateOrbitalVelocity(this.sprayTarget, position, this.physics.gravitationalConstant)
+                : manualVelocity;
+            this.sprayQueue.push({ position, velocity, mass, color });
         }
+    }
+
+    flushSprayQueue() {
+        if (this.sprayQueue.length === 0) return;
         
-        debugLog(`Initial force calculated for new body: ${newBody.force.magnitude().toFixed(2)}`);
+        const specs = this.sprayQueue;
+        this.sprayQueue = [];
+        // The frame's regular UI update follows
+        this.addBodies(specs, { notify: false, updateUI: false });
     }
 
     findNearestBody(position) {
@@ -886,7 +1647,7 @@ class NBodyApp {
         
         if (!targetBody) {
             this.renderer.setOrbitPreview(false);
-            this.renderer.setLongTermPreview(false);
+            this.clearLongTermPreview();
             return;
         }
         
@@ -908,13 +1669,62 @@ class NBodyApp {
         
         // Calculate long-term preview if enabled
         if (this.renderer.showLongTermPreview) {
-            const longTermData = this.renderer.calculateLongTermOrbitPreview(previewBody, this.bodies, this.physics);
-            this.renderer.setLongTermPreview(true, longTermData);
+            this.scheduleLongTermPreview(previewBody);
         } else {
-            this.renderer.setLongTermPreview(false);
+            this.clearLongTermPreview();
         }
     }
 
+    // Predict the long-term path as a background job; a newer request replaces a pending one
+    // and the last finished path stays on screen meanwhile
+    scheduleLongTermPreview(previewBody) {
+        const n = this.bodies.length;
+        const field = {
+            x: new Float64Array(n), y: new Float64Array(n),
+            vx: new Float64Array(n), vy: new Float64Array(n),
+            mass: new Float64Array(n), radius: new Float64Array(n)
+        };
+        for (let i = 0; i < n; i++) {
+            const body = this.bodies[i];
+            field.x[i] = body.position.x;
+            field.y[i] = body.position.y;
+            field.vx[i] = body.velocity.x;
+            field.vy[i] = body.velocity.y;
+            field.mass[i] = body.mass;
+            field.radius[i] = body.radius;
+        }
+        
+        this.scheduler.schedule({
+            type: 'orbit-prediction',
+            payload: {
+                ...field,
+                test: {
+                    x: previewBody.position.x,
+                    y: previewBody.position.y,
+                    vx: previewBody.velocity.x,
+                    vy: previewBody.velocity.y,
+                    mass: previewBody.mass,
+                    radius: previewBody.radius
+                },
+                gravitationalConstant: this.physics.gravitationalConstant,
+                softeningParameter: this.physics.softeningParameter,
+                timeStep: RENDERING_CONSTANTS.PREDICTION_TIME_STEP,
+                steps: RENDERING_CONSTANTS.MAX_PREDICTION_STEPS,
+                maxPoints: RENDERING_CONSTANTS.MAX_PREDICTION_POINTS,
+                maxFieldBodies: 32
+            }
+        }, {
+            key: 'long-term-preview',
+            priority: TASK_PRIORITY.NORMAL,
+            onComplete: result => this.renderer.setLongTermPreview(true, result)
+        });
+    }
+
+    clearLongTermPreview() {
+        this.scheduler.cancelKey('long-term-preview');
+        this.renderer.setLongTermPreview(false);
+    }
+
     findBodyAtPosition(position) {
         let closestBody = null;
         let minDistance = Infinity;
@@ -948,7 +1758,7 @@ class NBodyApp {
         // Only clear orbit previews when selecting existing bodies, not when adding new ones
         if (!isNewBody) {
             this.renderer.setOrbitPreview(false);
-            this.renderer.setLongTermPreview(false);
+            this.clearLongTermPreview();
         }
         
         this.selectedBody = body;
@@ -982,8 +1792,18 @@ class NBodyApp {
     // Preset and configuration management
     loadPreset(presetName) {
         try {
+            this.scheduler.cancelKey('load-configuration');
             this.bodies = Presets.getPreset(presetName);
+            this.bodies.forEach(body => {
+                if (body.maxTrailLength > this.trailLengthLimit) body.trimTrail(this.trailLengthLimit);
+            });
+            this.physics.setForceFields(Presets.getForceFields(presetName));
+            this.physics.escapers.clear();
+            this.resetGroupCatalog();
+            this.resetOrbitSurvey();
+            this.resetEnergyTracking();
             this.selectedBody = null;
+            this.discardWorkerStep();
             this.isRunning = false;
             this.isPaused = false;
             
@@ -1004,7 +1824,9 @@ class NBodyApp {
             physics: {
                 gravitationalConstant: this.physics.gravitationalConstant,
                 timeScale: this.physics.timeScale,
-                collisionEnabled: this.physics.collisionEnabled
+                collisionEnabled: this.physics.collisionEnabled,
+                forceFields: this.physics.getForceFields(),
+                escapers: this.physics.escapers.serialize(this.physics.simulationTime)
             },
             renderer: {
                 showTrails: this.renderer.showTrails,
@@ -1016,6 +1838,8 @@ class NBodyApp {
                 y: this.renderer.camera.y,
                 zoom: this.renderer.camera.zoom
             },
+            diagnostics: Diagnostics.getReport(),
+            groups: this.groupCatalog.toJSON(),
             timestamp: new Date().toISOString(),
             version: '1.0'
         };
@@ -1027,50 +1851,104 @@ class NBodyApp {
         this.ui.showNotification('Configuration saved!', 'success');
     }
 
+    // Returns false when a large configuration is still being loaded in the background
     loadConfiguration(config) {
-        try {
-            // Load bodies
-            this.bodies = config.bodies.map(bodyData => Body.fromJSON(bodyData));
-            
-            // Load physics settings
-            if (config.physics) {
-                this.physics.gravitationalConstant = config.physics.gravitationalConstant || 100;
-                this.physics.timeScale = config.physics.timeScale || 1.0;
-                this.physics.collisionEnabled = config.physics.collisionEnabled !== false;
-                
-                // Update UI
-                this.ui.updateSlider('gravity-strength', this.physics.gravitationalConstant / 100);
-                this.ui.updateSlider('time-scale', this.physics.timeScale);
-                this.ui.updateCheckbox('collision-enabled', this.physics.collisionEnabled);
-            }
-            
-            // Load renderer settings
-            if (config.renderer) {
-                this.renderer.showTrails = config.renderer.showTrails !== false;
-                this.renderer.showGrid = config.renderer.showGrid !== false;
-                this.renderer.showForces = config.renderer.showForces === true;
-                
-                // Update UI
-                this.ui.updateCheckbox('show-trails', this.renderer.showTrails);
-                this.ui.updateCheckbox('show-grid', this.renderer.showGrid);
-                this.ui.updateCheckbox('show-forces', this.renderer.showForces);
-            }
-            
-            // Load camera settings
-            if (config.camera) {
-                this.renderer.camera.x = config.camera.x || 0;
-                this.renderer.camera.y = config.camera.y || 0;
-                this.renderer.camera.zoom = config.camera.zoom || 1.0;
-                this.renderer.camera.targetZoom = this.renderer.camera.zoom;
-            }
+        if (!config || !Array.isArray(config.bodies)) {
+            throw new Error('Invalid configuration format: missing bodies');
+        }
+        
+        // Large scenes are rebuilt in slices so the page stays responsive meanwhile
+        if (config.bodies.length > PHYSICS_CONSTANTS.SLICED_IMPORT_THRESHOLD) {
+            const bodyData = config.bodies;
+            const bodies = new Array(bodyData.length);
             
-            this.selectedBody = null;
             this.isRunning = false;
-            this.isPaused = false;
-            
+            this.loadProgress = 0;
+            this.scheduler.schedule({
+                run: function* () {
+                    for (let i = 0; i < bodyData.length; i++) {
+                        bodies[i] = Body.fromJSON(bodyData[i]);
+                        if (i % 250 === 249) yield (i + 1) / bodyData.length;
+                    }
+                    return bodies;
+                }
+            }, {
+                key: 'load-configuration',
+                priority: TASK_PRIORITY.HIGH,
+                onProgress: progress => {
+                    this.loadProgress = progress;
+                },
+                onComplete: loaded => {
+                    this.loadProgress = null;
+                    this.applyConfiguration(config, loaded);
+                    this.ui.showNotification('Configuration loaded successfully!', 'success');
+                },
+                onError: error => {
+                    this.loadProgress = null;
+                    this.ui.showNotification('Error loading configuration: ' + error.message, 'error');
+                },
+                onCancel: () => {
+                    this.loadProgress = null;
+                }
+            });
+            return false;
+        }
+        
+        try {
+            this.applyConfiguration(config, config.bodies.map(bodyData => Body.fromJSON(bodyData)));
         } catch (error) {
             throw new Error('Invalid configuration format: ' + error.message);
         }
+        return true;
+    }
+
+    // Install loaded bodies and settings
+    applyConfiguration(config, bodies) {
+        // Load bodies
+        this.bodies = bodies;
+        this.physics.escapers.clear();
+        this.resetGroupCatalog();
+        this.resetOrbitSurvey();
+        this.resetEnergyTracking();
+        this.discardWorkerStep();
+        
+        // Load physics settings
+        if (config.physics) {
+            this.physics.gravitationalConstant = config.physics.gravitationalConstant || 100;
+            this.physics.timeScale = config.physics.timeScale || 1.0;
+            this.physics.collisionEnabled = config.physics.collisionEnabled !== false;
+            this.physics.setForceFields(config.physics.forceFields || []);
+            this.physics.escapers.load(config.physics.escapers, this.physics.simulationTime);
+            
+            // Update UI
+            this.ui.updateSlider('gravity-strength', this.physics.gravitationalConstant / 100);
+            this.ui.updateSlider('time-scale', this.physics.timeScale);
+            this.ui.updateCheckbox('collision-enabled', this.physics.collisionEnabled);
+        }
+        
+        // Load renderer settings
+        if (config.renderer) {
+            this.renderer.showTrails = config.renderer.showTrails !== false;
+            this.renderer.showGrid = config.renderer.showGrid !== false;
+            this.renderer.showForces = config.renderer.showForces === true;
+            
+            // Update UI
+            this.ui.updateCheckbox('show-trails', this.renderer.showTrails);
+            this.ui.updateCheckbox('show-grid', this.renderer.showGrid);
+            this.ui.updateCheckbox('show-forces', this.renderer.showForces);
+        }
+        
+        // Load camera settings
+        if (config.camera) {
+            this.renderer.camera.x = config.camera.x || 0;
+            this.renderer.camera.y = config.camera.y || 0;
+            this.renderer.camera.zoom = config.camera.zoom || 1.0;
+            this.renderer.camera.targetZoom = this.renderer.camera.zoom;
+        }
+        
+        this.selectedBody = null;
+        this.isRunning = false;
+        this.isPaused = false;
     }
 
     // Performance settings handler
@@ -1112,6 +1990,12 @@ class NBodyApp {
             case 'level-of-detail':
                 this.renderer.setLODEnabled(value);
                 break;
+            case 'dynamic-resolution':
+                this.renderer.setResolutionScaling(value);
+                break;
+            case 'render-scale-bounds':
+                this.renderer.setRenderScaleBounds(value.min, value.max);
+                break;
         }
     }
 
@@ -1156,12 +2040,22 @@ class NBodyApp {
         if (enabled && !this.physicsWorker) {
             this.initializeWebWorker();
         } else if (!enabled && this.physicsWorker) {
+            this.scheduler.setWorker(null);
             this.physicsWorker.terminate();
             this.physicsWorker = null;
             this.workerBusy = false;
+            this.workerMemory = null;
         }
     }
 
+    // Forget any in-flight worker step, e.g. after the scene was replaced
+    discardWorkerStep() {
+        this.workerSequence++;
+        this.workerBusy = false;
+        this.workerSentIds = null;
+        this.workerPendingTime = 0;
+    }
+
     // Initialize Web Worker for background physics
     initializeWebWorker() {
         try {
@@ -1170,33 +2064,66 @@ class NBodyApp {
             this.physicsWorker.onmessage = (e) => {
                 const { type, data } = e.data;
                 
+                // Replies to jobs offloaded by the scheduler
+                if (this.scheduler.handleWorkerMessage(type, data)) {
+                    return;
+                }
+                
                 switch (type) {
                     case 'simulation-result':
-                        // Check if worker is still supposed to be busy (prevent race conditions)
-                        if (!this.workerBusy) {
-                            console.warn('Received worker result but worker not marked as busy - ignoring stale result');
+                        // Ignore results for requests we already gave up on (prevent race conditions)
+                        if (!this.workerBusy || !data || data.sequence !== this.workerSequence) {
+                            console.warn('Received stale worker result - ignoring');
                             return;
                         }
                         
                         // Validate worker data before using it
-                        if (!data || !Array.isArray(data.bodies)) {
+                        if (!Array.isArray(data.bodies)) {
                             console.warn('Invalid worker data received, ignoring');
                             this.workerBusy = false;
                             return;
                         }
                         
+                        if (typeof data.simulationTime === 'number') {
+                            this.physics.simulationTime = data.simulationTime;
+                        }
+                        
                         // Update bodies with worker results
                         this.updateBodiesFromWorker(data.bodies);
                         
-                        // Update energy tracking
+                        // Mirror the worker engine's energy and timing so the UI reads one source
                         if (data.energy) {
                             this.physics.totalKineticEnergy = data.energy.kinetic || 0;
                             this.physics.totalPotentialEnergy = data.energy.potential || 0;
                             this.physics.totalEnergy = data.energy.total || 0;
+                            this.physics.potentialEnergyKnown = data.energy.potentialKnown !== false;
+                            this.physics.currentBodyCount = this.bodies.length;
+                            if (this.physics.potentialEnergyKnown) {
+                                this.physics.updateEnergyHistory();
+                            }
                         }
+                        if (data.performance) {
+                            this.physics.physicsTime = data.performance.physicsTime;
+                            this.physics.forceCalculationTime = data.performance.forceCalculationTime;
+                            this.physics.integrationTime = data.performance.integrationTime;
+                            this.recordPhysicsTimings(data.performance.physicsTime, data.performance.frameTimings);
+                        }
+                        this.flightRecorder.add(FRAME_PHASE.WORKER_WAIT, performance.now() - this.workerPostTime);
+                        if (data.barnesHutStats) {
+                            this.physics.barnesHutStats = data.barnesHutStats;
+                        }
+                        if (data.memory) {
+                            this.workerMemory = data.memory;
+                        }
+                        this.physics.updateEscapers(this.bodies);
+                        if (data.diagnostics) {
+                            Diagnostics.merge(data.diagnostics);
+                        }
+                        this.physics.costProfile.load(data.costProfile);
                         
                         // Mark worker as no longer busy
                         this.workerBusy = false;
+                        this.workerSentIds = null;
                         
                         // Clear timeout since worker completed successfully
                         if (this.workerTimeoutId) {
@@ -1208,6 +2135,9 @@ class NBodyApp {
                         this.workerTimeoutCount = 0;
                         break;
                         
+                    case 'configuration-updated':
+                        break;
+                        
                     case 'error':
                         console.error('Physics worker error:', data.message);
                         this.workerBusy = false; // Ensure flag is cleared on error
@@ -1229,12 +2159,9 @@ class NBodyApp {
             // Configure worker with current physics settings
             this.physicsWorker.postMessage({
                 type: 'configure',
-                data: {
-                    gravitationalConstant: this.physics.gravitationalConstant,
-                    softeningParameter: this.physics.softeningParameter,
-                    barnesHutTheta: this.physics.barnesHutTheta
-                }
+                data: this.physics.getConfiguration()
             });
+            this.scheduler.setWorker(this.physicsWorker);
             
         } catch (error) {
             console.error('Failed to initialize Web Worker:', error);
@@ -1242,71 +2169,111 @@ class NBodyApp {
         }
     }
 
-    // Update bodies from worker results
+    // Update bodies from worker results, matching by id. Bodies that were part of the
+    // request but are missing from the result were merged away in the worker; bodies
+    // added on this thread while the step was in flight are kept as they are.
     updateBodiesFromWorker(workerBodies) {
         if (!Array.isArray(workerBodies)) {
             console.warn('Invalid worker bodies data received');
             return;
         }
         
-        workerBodies.forEach((workerBody, index) => {
-            if (index < this.bodies.length && workerBody) {
-                const body = this.bodies[index];
-                
-                // Validate worker body data before applying
-                if (workerBody.position && 
-                    typeof workerBody.position.x === 'number' && 
-                    typeof workerBody.position.y === 'number' &&
-                    isFinite(workerBody.position.x) && 
-                    isFinite(workerBody.position.y)) {
-                    body.position.x = workerBody.position.x;
-                    body.position.y = workerBody.position.y;
-                }
-                
-                if (workerBody.velocity && 
-                    typeof workerBody.velocity.x === 'number' && 
-                    typeof workerBody.velocity.y === 'number' &&
-                    isFinite(workerBody.velocity.x) && 
-                    isFinite(workerBody.velocity.y)) {
-                    body.velocity.x = workerBody.velocity.x;
-                    body.velocity.y = workerBody.velocity.y;
-                }
+        const sentIds = this.workerSentIds || new Set();
+        const bodiesById = new Map();
+        this.bodies.forEach(body => bodiesById.set(body.id, body));
+        
+        const returnedIds = new Set();
+        const createdBodies = [];
+        
+        workerBodies.forEach(workerBody => {
+            if (!workerBody ||
+                !workerBody.position || !isFinite(workerBody.position.x) || !isFinite(workerBody.position.y) ||
+                !workerBody.velocity || !isFinite(workerBody.velocity.x) || !isFinite(workerBody.velocity.y)) {
+                return;
+            }
+            
+            returnedIds.add(workerBody.id);
+            let body = bodiesById.get(workerBody.id);
+            
+            if (!body) {
+                // Only bodies the worker created (merges) are new; anything else was deleted here meanwhile
+                if (sentIds.has(workerBody.id)) return;
                 
-                // Update energy values with validation
-                if (typeof workerBody.kineticEnergy === 'number' && isFinite(workerBody.kineticEnergy)) {
-                    body.kineticEnergy = workerBody.kineticEnergy;
-                }
-                if (typeof workerBody.potentialEnergy === 'number' && isFinite(workerBody.potentialEnergy)) {
-                    body.potentialEnergy = workerBody.potentialEnergy;
-                }
+                body = new Body(
+                    new Vector2D(workerBody.position.x, workerBody.position.y),
+                    new Vector2D(workerBody.velocity.x, workerBody.velocity.y),
+                    workerBody.mass,
+                    workerBody.color,
+                    workerBody.trailLength
+                );
+                // Worker ids come from their own range; the local counter stays out of it
+                body.id = workerBody.id;
+                createdBodies.push(body);
+            } else if (!body.beingDragged) {
+                body.position.x = workerBody.position.x;
+                body.position.y = workerBody.position.y;
+                body.velocity.x = workerBody.velocity.x;
+                body.velocity.y = workerBody.velocity.y;
                 
-                // Update trails if needed (with validation)
-                if (Array.isArray(workerBody.trail)) {
-                    body.trail = workerBody.trail;
+                if (body.mass !== workerBody.mass) {
+                    body.mass = workerBody.mass;
+                    body.updateRadius();
                 }
             }
+            
+            // Update energy values with validation
+            if (typeof workerBody.kineticEnergy === 'number' && isFinite(workerBody.kineticEnergy)) {
+                body.kineticEnergy = workerBody.kineticEnergy;
+            }
+            if (typeof workerBody.potentialEnergy === 'number' && isFinite(workerBody.potentialEnergy)) {
+                body.potentialEnergy = workerBody.potentialEnergy;
+            }
+            
+            // Trails are kept on this thread rather than shipped with every result
+            body.sampleTrail(this.physics.simulationTime);
         });
+        
+        // Drop bodies the worker merged away
+        const survivingBodies = this.bodies.filter(body => !sentIds.has(body.id) || returnedIds.has(body.id));
+        if (survivingBodies.length !== this.bodies.length) {
+            if (this.selectedBody && !survivingBodies.includes(this.selectedBody)) {
+                this.selectBody(null);
+            }
+            this.bodies.length = 0;
+            this.bodies.push(...survivingBodies);
+        }
+        
+        this.bodies.push(...createdBodies);
     }
 
     // Enhanced update method with Web Worker and GPU support
     update(deltaTime) {
+        // Sprayed bodies enter the simulation as one batch per frame
+        this.flushSprayQueue();
+        
         // Validate and clean up bodies before physics update
         this.validateAndCleanBodies();
         
         if (this.isRunning && !this.isPaused) {
+            const physicsStart = performance.now();
             if (this.useGPU && this.physics.gpuPhysics && this.physics.gpuPhysics.isReady() && this.bodies.length > 0) {
                 // Use GPU acceleration for physics
                 this.updateWithGPU(deltaTime);
-            } else if (this.useWebWorkers && this.physicsWorker && !this.workerBusy && this.bodies.length > 8) {
+                this.recordPhysicsTimings(performance.now() - physicsStart, null);
+            } else if (this.useWebWorkers && this.physicsWorker && this.bodies.length > 8) {
                 // Use Web Worker for large simulations
                 this.updateWithWebWorker(deltaTime);
+                this.flightRecorder.add(FRAME_PHASE.WORKER_POST, performance.now() - physicsStart);
             } else {
                 // Use main thread physics
                 this.physics.update(this.bodies, deltaTime);
+                this.recordPhysicsTimings(performance.now() - physicsStart, this.physics.frameTimings);
             }
         }
         
+        const uiStart = performance.now();
         this.updateUI();
+        this.flightRecorder.add(FRAME_PHASE.UI, performance.now() - uiStart);
     }
 
     // Update simulation using GPU acceleration
@@ -1340,46 +2307,59 @@ class NBodyApp {
         }
     }
 
-    // Update simulation using Web Worker
+    // Update simulation using Web Worker. The worker owns the simulation state while it is
+    // active; this thread forwards its edits and elapsed time and never steps the bodies itself.
     updateWithWebWorker(deltaTime) {
+        // Cap the backlog so a stalled worker cannot trigger a burst of catch-up substeps
+        this.workerPendingTime = Math.min(this.workerPendingTime + deltaTime, PHYSICS_CONSTANTS.MAX_TIME_STEP * 8);
+        
         if (this.workerBusy) {
-            // Worker is busy, fall back to CPU physics for this frame
-            this.physics.update(this.bodies, deltaTime);
             return;
         }
         
+        const stepTime = this.workerPendingTime;
+        this.workerPendingTime = 0;
         this.workerBusy = true;
+        this.workerSequence++;
         
         try {
-            // Serialize bodies for worker
+            // Serialize the minimal body state; the worker keeps everything else between steps
             const serializedBodies = this.bodies.map(body => ({
                 id: body.id,
                 position: { x: body.position.x, y: body.position.y },
                 velocity: { x: body.velocity.x, y: body.velocity.y },
                 mass: body.mass,
-                radius: body.radius,
                 color: body.color,
-                trail: body.trail || []
+                trailLength: body.maxTrailLength,
+                fixed: body.fixed,
+                beingDragged: body.beingDragged
             }));
+            this.workerSentIds = new Set(serializedBodies.map(body => body.id));
             
             // Send simulation step to worker
+            this.workerPostTime = performance.now();
             this.physicsWorker.postMessage({
-                type: 'simulate',
+                type: 'step',
                 data: {
+                    sequence: this.workerSequence,
                     bodies: serializedBodies,
-                    deltaTime: deltaTime,
-                    config: {
-                        integrationMethod: this.physics.integrationMethod,
-                        forceMethod: this.physics.forceCalculationMethod
-                    }
+                    deltaTime: stepTime,
+                    config: this.physics.getConfiguration(),
+                    energyGeneration: this.physics.energyGeneration,
+                    reportMemory: this.workerMemoryRequested
                 }
             });
+            this.workerMemoryRequested = false;
             
             // Set a timeout to prevent worker from hanging indefinitely
+            const sequence = this.workerSequence;
             this.workerTimeoutId = setTimeout(() => {
-                if (this.workerBusy) {
+                if (this.workerBusy && this.workerSequence === sequence) {
                     console.warn('Worker timeout - forcing worker busy flag reset');
                     this.workerBusy = false;
+                    this.workerSentIds = null;
+                    // Invalidate the late result; the next request re-syncs the worker from this thread
+                    this.workerSequence++;
                     // Optionally restart the worker if it's consistently timing out
                     this.workerTimeoutCount = (this.workerTimeoutCount || 0) + 1;
                     if (this.workerTimeoutCount > 3) {
@@ -1392,8 +2372,9 @@ class NBodyApp {
         } catch (error) {
             console.error('Error sending data to worker:', error);
             this.workerBusy = false;
+            this.workerSentIds = null;
             // Fall back to CPU physics
-            this.physics.update(this.bodies, deltaTime);
+            this.physics.update(this.bodies, stepTime);
         }
     }
 
@@ -4,9 +4,10 @@
  */
 
 class QuadTree {
-    constructor(bounds, maxBodies = 1, depth = 0, maxDepth = 20) {
+    constructor(bounds, maxBodies = 1, depth = 0, maxDepth = 20, minCellSize = 0) {
         this.bounds = bounds; // {x, y, width, height}
         this.maxBodies = maxBodies;
+        this.minCellSize = minCellSize; // Cells are never split below this size
         this.bodies = [];
         this.children = null;
         this.centerOfMass = null;
@@ -32,12 +33,23 @@ class QuadTree {
             return true;
         }
 
+        // Leaves at the minimum cell size, or holding bodies on the exact same point,
+        // become buckets; splitting them could not separate anything
+        if (!this.divided && (Math.max(this.bounds.width, this.bounds.height) * 0.5 < this.minCellSize ||
+            this.bodies.every(other => other.position.x === body.position.x && other.position.y === body.position.y))) {
+            this.bodies.push(body);
+            this.updateCenterOfMass();
+            return true;
+        }
+
         // Check depth limit to prevent stack overflow
         if (this.depth >= this.maxDepth) {
             // Force add to this node even if it exceeds maxBodies
             this.bodies.push(body);
             this.updateCenterOfMass();
-            console.warn(`QuadTree depth limit reached (${this.maxDepth}), forcing body insertion`);
+            if (Diagnostics.counts[DIAGNOSTIC.QUADTREE_DEPTH_LIMIT]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.QUADTREE_DEPTH_LIMIT, `depth ${this.maxDepth} reached, body ${body.id} forced into a leaf`);
+            }
             return true;
         }
 
@@ -82,11 +94,12 @@ class QuadTree {
         const w = this.bounds.width / 2;
         const h = this.bounds.height / 2;
 
+        const depth = this.depth + 1;
         this.children = {
-            nw: new QuadTree({ x: x, y: y, width: w, height: h }, this.maxBodies, this.depth + 1, this.maxDepth),
-            ne: new QuadTree({ x: x + w, y: y, width: w, height: h }, this.maxBodies, this.depth + 1, this.maxDepth),
-            sw: new QuadTree({ x: x, y: y + h, width: w, height: h }, this.maxBodies, this.depth + 1, this.maxDepth),
-            se: new QuadTree({ x: x + w, y: y + h, width: w, height: h }, this.maxBodies, this.depth + 1, this.maxDepth)
+            nw: new QuadTree({ x: x, y: y, width: w, height: h }, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            ne: new QuadTree({ x: x + w, y: y, width: w, height: h }, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            sw: new QuadTree({ x: x, y: y + h, width: w, height: h }, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            se: new QuadTree({ x: x + w, y: y + h, width: w, height: h }, this.maxBodies, depth, this.maxDepth, this.minCellSize)
         };
 
         this.divided = true;
@@ -287,12 +300,14 @@ class QuadTree {
 class BarnesHutCalculator {
     constructor(theta = 0.5) {
         this.theta = theta; // Barnes-Hut approximation parameter
+        this.leafCapacity = PHYSICS_CONSTANTS.BARNES_HUT_LEAF_CAPACITY; // Bodies per leaf bucket
+        this.minCellSoftening = PHYSICS_CONSTANTS.BARNES_HUT_MIN_CELL_SOFTENING; // Smallest cell, in softening lengths
     }
 
     /**
      * Calculate forces for all bodies using Barnes-Hut algorithm
      */
-    calculateForces(bodies, gravitationalConstant = 100) {
+    calculateForces(bodies, gravitationalConstant = 100, softeningParameter = PHYSICS_CONSTANTS.SOFTENING_PARAMETER) {
         if (bodies.length === 0) return;
 
         // Reset all forces
@@ -302,15 +317,15 @@ class BarnesHutCalculator {
         const bounds = this.calculateBounds(bodies);
         
         // Build the quadtree
-        const quadTree = new QuadTree(bounds);
+        const minCellSize = softeningParameter * this.minCellSoftening;
+        const quadTree = new QuadTree(bounds, this.leafCapacity, 0, 20, minCellSize);
         for (const body of bodies) {
             quadTree.insert(body);
         }
 
-        // Calculate forces for each body
+        // Calculate forces for each body; the tree applies them directly
         for (const body of bodies) {
-            const force = quadTree.calculateForce(body, this.theta, gravitationalConstant);
-            body.force = body.force.add(force);
+            quadTree.calculateForce(body, gravitationalConstant, softeningParameter, this.theta);
         }
     }
 
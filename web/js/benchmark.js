@@ -0,0 +1,335 @@
+/**
+ * Reproducible benchmark
+ * Runs a fixed ladder of scenes (a preset plus seeded synthetic discs) through a
+ * matrix of renderer, force method and worker settings on this machine, rendering
+ * included. Every run starts from the same bodies, is fed one fixed physics step of
+ * time per frame and ends after the same number of steps, so two machines do the
+ * same work and differ only in how fast. Steps are counted from the phase timings
+ * rather than read from the simulation clock, which the worker keeps separately.
+ * The app drives the runs from its frame loop; this class holds the plan, collects
+ * the per-frame samples and builds the report.
+ */
+
+class BenchmarkRunner {
+    constructor() {
+        this.active = false;
+        this.plan = []; // Runs in order: { scene, bodyCount, renderer, forceMethod, workers }
+        this.runIndex = -1;
+        this.results = [];
+        this.report = null; // Last finished (or cancelled) benchmark
+        this.environment = null;
+        
+        // Samples of the current run, preallocated for the longest run allowed
+        const maxFrames = RENDERING_CONSTANTS.BENCHMARK_MAX_FRAMES;
+        this.frameTimes = new Float64Array(maxFrames);
+        this.physicsTimes = new Float64Array(maxFrames);
+        this.renderTimes = new Float64Array(maxFrames);
+        this.sampleCount = 0;
+        this.stepCount = 0; // Physics steps reported over the measured frames
+        this.totalSteps = 0; // Physics steps since the run started, warm-up included
+        this.stepSize = 0; // Simulated seconds per step
+        this.targetSteps = 0; // Steps in the simulated duration
+        this.frameNumber = 0; // Frames since the run started, warm-up included
+        this.lastFrameTime = 0;
+        this.runStartTime = 0;
+        this.runStartEnergy = null;
+    }
+
+    /**
+     * Scene ladder and configuration matrix. Direct summation is only run on scenes
+     * small enough for it, and WebGL and worker runs only where they are available.
+     */
+    static createPlan(options = {}) {
+        const scenes = [{ scene: 'solar-system', bodyCount: Presets.getPreset('solar-system').length }];
+        RENDERING_CONSTANTS.BENCHMARK_BODY_COUNTS.forEach(bodyCount => {
+            scenes.push({ scene: 'disc', bodyCount });
+        });
+        
+        const renderers = options.webgl ? ['canvas2d', 'webgl'] : ['canvas2d'];
+        const workerModes = options.workers ? [false, true] : [false];
+        const plan = [];
+        scenes.forEach(({ scene, bodyCount }) => {
+            renderers.forEach(renderer => {
+                ['naive', 'barnes-hut'].forEach(forceMethod => {
+                    if (forceMethod === 'naive' && bodyCount > RENDERING_CONSTANTS.BENCHMARK_DIRECT_MAX_BODIES) return;
+                    workerModes.forEach(workers => {
+                        plan.push({ scene, bodyCount, renderer, forceMethod, workers });
+                    });
+                });
+            });
+        });
+        return plan;
+    }
+
+    /**
+     * Bodies for a plan entry. Synthetic scenes are a disc of light bodies on circular
+     * orbits about a central mass, drawn from a seeded generator.
+     */
+    static createScene(run, seed = RENDERING_CONSTANTS.BENCHMARK_SEED) {
+        if (run.scene !== 'disc') {
+            return Presets.getPreset(run.scene);
+        }
+        
+        const random = BenchmarkRunner.createRandom(seed + run.bodyCount);
+        const G = PHYSICS_CONSTANTS.GRAVITATIONAL_CONSTANT;
+        const centralMass = 1000;
+        const discMass = 200;
+        const innerRadius = 40;
+        const outerRadius = 400;
+        const count = run.bodyCount - 1;
+        const colors = ['#64ffda', '#bb86fc', '#03dac6', '#90caf9', '#ffb74d'];
+        
+        const bodies = [new Body(new Vector2D(0, 0), new Vector2D(0, 0), centralMass, '#ffd54f', 20)];
+        for (let i = 0; i < count; i++) {
+            // Uniform surface density, so the disc mass inside r grows with the area
+            const u = random();
+            const radius = Math.sqrt(innerRadius * innerRadius + u * (outerRadius * outerRadius - innerRadius * innerRadius));
+            const angle = random() * 2 * Math.PI;
+            const enclosed = centralMass + discMass * u;
+            const speed = Math.sqrt(G * enclosed / radius);
+            
+            bodies.push(new Body(
+                new Vector2D(radius * Math.cos(angle), radius * Math.sin(angle)),
+                new Vector2D(-speed * Math.sin(angle), speed * Math.cos(angle)),
+                discMass / count * (0.5 + random()),
+                colors[Math.floor(random() * colors.length)],
+                20
+            ));
+        }
+        return bodies;
+    }
+
+    // Mulberry32: small, fast and identical on every engine
+    static createRandom(seed) {
+        let state = seed >>> 0;
+        return () => {
+            state = (state + 0x6D2B79F5) >>> 0;
+            let t = state;
+            t = Math.imul(t ^ (t >>> 15), t | 1);
+            t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+            return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+        };
+    }
+
+    /**
+     * Total energy with the exact O(N²) potential (the 'energy-audit' job, run to the
+     * end here); null above BENCHMARK_DRIFT_MAX_BODIES, where drift is not measured
+     */
+    static measureEnergy(bodies, gravitationalConstant, softeningParameter) {
+        const n = bodies.length;
+        if (n === 0 || n > RENDERING_CONSTANTS.BENCHMARK_DRIFT_MAX_BODIES) return null;
+        
+        const payload = {
+            x: new Float64Array(n),
+            y: new Float64Array(n),
+            mass: new Float64Array(n),
+            gravitationalConstant,
+            softeningParameter
+        };
+        let kinetic = 0;
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            payload.x[i] = body.position.x;
+            payload.y[i] = body.position.y;
+            payload.mass[i] = body.mass;
+            kinetic += 0.5 * body.mass * (body.velocity.x * body.velocity.x + body.velocity.y * body.velocity.y);
+        }
+        
+        const job = SCHEDULER_JOBS['energy-audit'](payload);
+        let step = job.next();
+        while (!step.done) {
+            step = job.next();
+        }
+        return kinetic + step.value.potentialEnergy;
+    }
+
+    begin(plan, environment) {
+        this.active = true;
+        this.plan = plan;
+        this.runIndex = -1;
+        this.results = [];
+        this.report = null;
+        this.environment = environment;
+    }
+
+    hasNextRun() {
+        return this.runIndex + 1 < this.plan.length;
+    }
+
+    nextRun() {
+        this.runIndex++;
+        return this.plan[this.runIndex];
+    }
+
+    getCurrentRun() {
+        return this.active && this.runIndex >= 0 ? this.plan[this.runIndex] : null;
+    }
+
+    // Called once the scene and settings of the current run are in place
+    startRun(now, stepSize, energy) {
+        this.sampleCount = 0;
+        this.stepCount = 0;
+        this.totalSteps = 0;
+        this.stepSize = stepSize;
+        this.targetSteps = Math.max(1, Math.round(RENDERING_CONSTANTS.BENCHMARK_SIMULATED_DURATION / stepSize));
+        this.frameNumber = 0;
+        this.lastFrameTime = 0;
+        this.runStartTime = now;
+        this.runStartEnergy = energy;
+    }
+
+    getSimulatedTime() {
+        return this.totalSteps * this.stepSize;
+    }
+
+    /**
+     * One frame of the current run: its start time (the rAF timestamp) and the physics
+     * and render phase times and physics steps recorded for it. Returns true once the
+     * run is over.
+     */
+    recordFrame(now, physicsTime, steps, renderTime) {
+        if (this.frameNumber >= RENDERING_CONSTANTS.BENCHMARK_WARMUP_FRAMES && this.lastFrameTime > 0 &&
+            this.sampleCount < this.frameTimes.length) {
+            const k = this.sampleCount++;
+            this.frameTimes[k] = now - this.lastFrameTime;
+            this.physicsTimes[k] = physicsTime;
+            this.renderTimes[k] = renderTime;
+            this.stepCount += steps;
+        }
+        this.frameNumber++;
+        this.lastFrameTime = now;
+        this.totalSteps += steps;
+        
+        return this.totalSteps >= this.targetSteps ||
+            this.sampleCount >= this.frameTimes.length ||
+            now - this.runStartTime >= RENDERING_CONSTANTS.BENCHMARK_MAX_RUN_TIME;
+    }
+
+    finishRun(now, energy, details = {}) {
+        const run = this.plan[this.runIndex];
+        const count = this.sampleCount;
+        const frameTimes = this.frameTimes.slice(0, count).sort();
+        const percentile = q => BenchmarkRunner.percentile(frameTimes, q);
+        const mean = values => {
+            let sum = 0;
+            for (let k = 0; k < count; k++) sum += values[k];
+            return count > 0 ? sum / count : 0;
+        };
+        
+        let physicsTotal = 0;
+        for (let k = 0; k < count; k++) physicsTotal += this.physicsTimes[k];
+        const startEnergy = this.runStartEnergy;
+        const simulated = this.getSimulatedTime();
+        
+        this.results.push({
+            ...run,
+            ...details,
+            frames: count,
+            simulatedTime: simulated,
+            wallTime: (now - this.runStartTime) / 1000,
+            truncated: this.totalSteps < this.targetSteps,
+            frameTime: { mean: mean(this.frameTimes), p50: percentile(0.5), p95: percentile(0.95), p99: percentile(0.99), max: percentile(1) },
+            fps: {
+                mean: count > 0 ? 1000 / mean(this.frameTimes) : 0,
+                p50: count > 0 ? 1000 / percentile(0.5) : 0,
+                low1: count > 0 ? 1000 / percentile(0.99) : 0 // "1% low": the rate of the slowest 1% of frames
+            },
+            physicsPerFrame: mean(this.physicsTimes),
+            physicsPerStep: this.stepCount > 0 ? physicsTotal / this.stepCount : null,
+            renderPerFrame: mean(this.renderTimes),
+            energyDrift: startEnergy !== null && energy !== null && startEnergy !== 0
+                ? Math.abs((energy - startEnergy) / startEnergy)
+                : null
+        });
+    }
+
+    // Ends the benchmark; a cancelled benchmark keeps the runs it finished
+    finish(cancelled = false) {
+        this.active = false;
+        this.report = {
+            version: '1.0',
+            time: new Date().toISOString(),
+            cancelled,
+            seed: RENDERING_CONSTANTS.BENCHMARK_SEED,
+            simulatedDuration: RENDERING_CONSTANTS.BENCHMARK_SIMULATED_DURATION,
+            warmupFrames: RENDERING_CONSTANTS.BENCHMARK_WARMUP_FRAMES,
+            environment: this.environment,
+            runs: this.results
+        };
+        return this.report;
+    }
+
+    // Linear interpolation between closest ranks of an ascending array
+    static percentile(sorted, q) {
+        if (sorted.length === 0) return 0;
+        const position = q * (sorted.length - 1);
+        const lower = Math.floor(position);
+        const upper = Math.min(lower + 1, sorted.length - 1);
+        return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - lower);
+    }
+
+    getStatus() {
+        const run = this.getCurrentRun();
+        return {
+            active: this.active,
+            run,
+            runNumber: this.runIndex + 1,
+            runCount: this.plan.length,
+            report: this.report
+        };
+    }
+
+    /**
+     * Standalone HTML page: a table of the runs, with the JSON report embedded so the
+     * file alone is enough to compare machines
+     */
+    static toHTML(report) {
+        const escape = text => String(text).replace(/[&<>"]/g, c => ({ '&': '&amp;', '<': '&lt;', '>': '&gt;', '"': '&quot;' })[c]);
+        const fixed = (value, digits) => value === null || !isFinite(value) ? '–' : value.toFixed(digits);
+        const environment = report.environment || {};
+        
+        const rows = report.runs.map(run => `<tr${run.truncated ? ' class="truncated"' : ''}>` +
+            `<td>${escape(run.scene)}</td><td>${run.bodyCount}</td><td>${escape(run.activeRenderer || run.renderer)}</td>` +
+            `<td>${escape(run.forceMethod)}</td><td>${run.workers ? 'on' : 'off'}</td>` +
+            `<td>${fixed(run.fps.p50, 1)}</td><td>${fixed(run.fps.low1, 1)}</td>` +
+            `<td>${fixed(run.frameTime.p50, 2)}</td><td>${fixed(run.frameTime.p95, 2)}</td><td>${fixed(run.frameTime.p99, 2)}</td>` +
+            `<td>${fixed(run.physicsPerStep, 2)}</td><td>${fixed(run.renderPerFrame, 2)}</td>` +
+            `<td>${run.energyDrift === null ? '–' : run.energyDrift.toExponential(2)}</td></tr>`).join('\n');
+        
+        // Keep the embedded JSON from closing the script element
+        const json = JSON.stringify(report, null, 2).replace(/</g, '\\u003c');
+        
+        return `<!DOCTYPE html>
+<html lang="en">
+<head>
+<meta charset="utf-8">
+<title>CelestialSim benchmark ${escape(report.time)}</title>
+<style>
+body { font-family: sans-serif; background: #111; color: #ddd; }
+table { border-collapse: collapse; }
+th, td { padding: 4px 10px; border-bottom: 1px solid #333; text-align: right; }
+th { color: #64ffda; }
+tr.truncated td { color: #ffb74d; }
+</style>
+</head>
+<body>
+<h1>CelestialSim benchmark</h1>
+<p>${escape(report.time)}${report.cancelled ? ' (cancelled)' : ''} &middot; ${escape(environment.userAgent || '')}</p>
+<p>${environment.hardwareConcurrency || '?'} threads &middot; canvas ${environment.canvasWidth}&times;${environment.canvasHeight} at ${environment.devicePixelRatio}x &middot; seed ${report.seed} &middot; ${report.simulatedDuration} s simulated per run. Orange rows hit the time limit.</p>
+<table>
+<tr><th>Scene</th><th>Bodies</th><th>Renderer</th><th>Forces</th><th>Worker</th><th>FPS p50</th><th>FPS 1% low</th><th>Frame p50 (ms)</th><th>p95</th><th>p99</th><th>Physics/step (ms)</th><th>Render (ms)</th><th>Energy drift</th></tr>
+${rows}
+</table>
+<script type="application/json" id="benchmark-report">
+${json}
+</script>
+</body>
+</html>
+`;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { BenchmarkRunner };
+}
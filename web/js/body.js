@@ -26,6 +26,10 @@ class Body {
         this.color = color;
         this.trail = [];
         this.maxTrailLength = Math.max(0, Math.floor(trailLength)); // Ensure integer and non-negative
+        this.lastTrailTime = -Infinity; // Simulated time of the newest trail point
+        this.trailDirectionX = 0; // Unit direction of the newest trail segment (zero before there is one)
+        this.trailDirectionY = 0;
+        this.trailHistory = null; // Decimated history older than the trail (TieredTrail), while Body.keepTrailHistory is on
         this.radius = this.calculateRadius();
         this.selected = false;
         this.hovered = false; // Add hover state
@@ -41,11 +45,13 @@ class Body {
         this.lastPosition = position.clone();
         
         // Collision properties
-        this.collisionCooldowns = new Map(); // Time-based cooldowns with specific bodies
         this.lastCollisionPartner = null; // Prevent immediate re-collision
         this.inCollision = false; // Track if currently in collision state
         this.collisionTime = 0; // How long in collision
         this.hasCollidedThisFrame = false; // Flag for current frame
+        this.sleeping = false; // Resting inside a sleeping contact island
+        this.sleepTimer = 0; // Time spent at rest relative to its contact island
+        this.sleepIsland = null; // Shared island record while sleeping
         
         // Energy tracking
         this.kineticEnergy = 0;
@@ -53,6 +59,10 @@ class Body {
     }
 
     static idCounter = 0;
+    static keepTrailHistory = false; // Points leaving the trail are kept, decimated, in trailHistory
+    static trailHistoryTiers = RENDERING_CONSTANTS.TRAIL_HISTORY_TIERS; // Tiers given to new histories (lowered by the memory ledger)
+    static trailSampleDistance = 0; // World distance between trail points, set from the camera zoom by the app
+    static trailSampleAngle = RENDERING_CONSTANTS.TRAIL_SAMPLE_ANGLE; // Turn that records a point sooner
     static generateId() {
         return ++Body.idCounter;
     }
@@ -64,7 +74,9 @@ class Body {
         
         // Validate that safeMass is finite
         if (!isFinite(safeMass)) {
-            console.warn(`Body ${this.id}: Non-finite mass detected, using fallback`);
+            if (Diagnostics.counts[DIAGNOSTIC.BODY_NON_FINITE_MASS]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.BODY_NON_FINITE_MASS, `body ${this.id} mass ${this.mass}`);
+            }
             return RENDERING_CONSTANTS.MIN_BODY_RADIUS;
         }
         
@@ -101,6 +113,11 @@ class Body {
             this.trail.push(this.position.clone());
         } else {
             // Trail is full, use circular buffer - properly clean up old reference
+            const oldest = this.trail[this.trailIndex];
+            if (oldest && Body.keepTrailHistory) {
+                if (!this.trailHistory) this.trailHistory = new TieredTrail(Body.trailHistoryTiers);
+                this.trailHistory.push(oldest.x, oldest.y);
+            }
             if (this.trail[this.trailIndex]) {
                 // Clear old position reference to prevent memory leaks
                 this.trail[this.trailIndex] = null;
@@ -116,6 +133,74 @@ class Body {
         }
     }
     
+    // Add a trail point once the body has moved Body.trailSampleDistance from the newest
+    // one, or less far along a path that has turned by Body.trailSampleAngle since the
+    // newest segment. Slow bodies then stop filling their trails with duplicates and
+    // points are spent where the path bends.
+    sampleTrail(simulationTime) {
+        if (this.maxTrailLength <= 0) return;
+        
+        // A reset or reload moves the clock back; start sampling afresh
+        const length = this.trail.length;
+        if (length > 0 && simulationTime >= this.lastTrailTime) {
+            const newest = this.trailPoint(length - 1);
+            const dx = this.position.x - newest.x;
+            const dy = this.position.y - newest.y;
+            const distance = Math.sqrt(dx * dx + dy * dy);
+            const spacing = Body.trailSampleDistance;
+            
+            if (distance < spacing) {
+                // Moves too short to give a direction are never recorded
+                if (distance < spacing * 0.25 || (this.trailDirectionX === 0 && this.trailDirectionY === 0)) {
+                    return;
+                }
+                const turn = Math.atan2(
+                    this.trailDirectionX * dy - this.trailDirectionY * dx,
+                    this.trailDirectionX * dx + this.trailDirectionY * dy
+                );
+                if (Math.abs(turn) < Body.trailSampleAngle) return;
+            }
+            
+            if (distance > 0) {
+                this.trailDirectionX = dx / distance;
+                this.trailDirectionY = dy / distance;
+            }
+        } else {
+            this.trailDirectionX = 0;
+            this.trailDirectionY = 0;
+        }
+        
+        this.lastTrailTime = simulationTime;
+        this.addToTrail();
+    }
+    
+    // k-th oldest trail point, read in place from the circular buffer
+    trailPoint(k) {
+        if (this.trail.length < this.maxTrailLength || this.trailIndex === undefined) {
+            return this.trail[k];
+        }
+        return this.trail[(this.trailIndex + k) % this.trail.length];
+    }
+    
+    // Shorten the trail to its newest `length` points. The points dropped go on into the
+    // history, as if they had aged out of the trail.
+    trimTrail(length) {
+        length = Math.max(0, Math.floor(length));
+        if (length >= this.maxTrailLength) return;
+        
+        const ordered = this.getOrderedTrail();
+        const dropped = Math.max(0, ordered.length - length);
+        if (Body.keepTrailHistory && dropped > 0) {
+            if (!this.trailHistory) this.trailHistory = new TieredTrail(Body.trailHistoryTiers);
+            for (let i = 0; i < dropped; i++) {
+                this.trailHistory.push(ordered[i].x, ordered[i].y);
+            }
+        }
+        this.trail = ordered.slice(dropped);
+        this.trailIndex = 0;
+        this.maxTrailLength = length;
+    }
+    
     // Get trail points in correct order for rendering
     getOrderedTrail() {
         if (this.trail.length < this.maxTrailLength || this.trailIndex === undefined) {
@@ -137,21 +222,27 @@ class Body {
     clearTrail() {
         this.trail = [];
         this.trailIndex = 0;
+        this.lastTrailTime = -Infinity;
+        this.trailDirectionX = 0;
+        this.trailDirectionY = 0;
+        this.trailHistory = null;
     }
 
     // Update physics - Verlet integration for better stability
+    // Dynamics only; trails and visuals are handled once per frame in finishFrame
     update(deltaTime) {
         if (this.fixed) return;
         
         // Validate deltaTime
         if (typeof deltaTime !== 'number' || deltaTime <= 0 || !isFinite(deltaTime)) {
-            console.warn(`Body ${this.id}: Invalid deltaTime (${deltaTime}), skipping update`);
+            if (Diagnostics.counts[DIAGNOSTIC.BODY_INVALID_TIMESTEP]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.BODY_INVALID_TIMESTEP, `body ${this.id} deltaTime ${deltaTime}, update skipped`);
+            }
             return;
         }
         
         // Validate current state before updating
         if (!this.validateState()) {
-            console.warn(`Body ${this.id}: Invalid state detected, attempting correction`);
             this.correctState();
         }
 
@@ -184,21 +275,6 @@ class Body {
             this.lastPosition = tempPosition;
         }
 
-        // Calculate kinetic energy
-        this.kineticEnergy = 0.5 * this.mass * this.velocity.magnitudeSquared();
-
-        // Update collision cooldowns (time-based)
-        this.updateCollisionCooldowns(deltaTime);
-        
-        // Reset frame-based collision flag
-        this.hasCollidedThisFrame = false;
-
-        // Add to trail
-        this.addToTrail();
-
-        // Update visual effects
-        this.updateVisualEffects(deltaTime);
-
         // Reset force for next frame
         this.resetForce();
     }
@@ -212,24 +288,24 @@ class Body {
         this.lastPosition = this.position.clone();
         this.position.addMut(this.velocity.multiply(deltaTime));
 
-        this.kineticEnergy = 0.5 * this.mass * this.velocity.magnitudeSquared();
-        
-        // Update collision cooldowns (time-based)
-        this.updateCollisionCooldowns(deltaTime);
-        
-        // Reset frame-based collision flag
-        this.hasCollidedThisFrame = false;
-        
-        this.addToTrail();
-        this.updateVisualEffects(deltaTime);
         this.resetForce();
     }
 
+    // Bookkeeping that does not feed back into the dynamics, run once per frame after all
+    // of the frame's physics steps: glow easing and trail sampling.
+    // Kinetic energy is filled in by the engine's energy pass.
+    finishFrame(frameTime, simulationTime, sampleTrail = true) {
+        this.updateVisualEffects(frameTime);
+        if (sampleTrail) {
+            this.sampleTrail(simulationTime);
+        }
+    }
+
     // Update visual effects like glow
     updateVisualEffects(deltaTime) {
-        // Smooth glow transition
+        // Smooth glow transition (capped so a long frame cannot overshoot the target)
         const glowSpeed = 5.0;
-        this.glowIntensity += (this.targetGlow - this.glowIntensity) * glowSpeed * deltaTime;
+        this.glowIntensity += (this.targetGlow - this.glowIntensity) * Math.min(1, glowSpeed * deltaTime);
     }
 
     // Reset force accumulator
@@ -346,6 +422,8 @@ class Body {
         );
         cloned.fixed = this.fixed;
         cloned.trail = this.trail.map(pos => pos.clone());
+        cloned.trailIndex = this.trailIndex;
+        cloned.trailHistory = this.trailHistory ? this.trailHistory.clone() : null;
         return cloned;
     }
 
@@ -452,31 +530,6 @@ class Body {
         };
     }
 
-    // Collision cooldown management methods
-    setCollisionCooldownWith(otherBody, cooldownTime) {
-        this.collisionCooldowns.set(otherBody.id, cooldownTime);
-    }
-
-    isInCollisionCooldownWith(otherBody) {
-        return this.collisionCooldowns.has(otherBody.id) && this.collisionCooldowns.get(otherBody.id) > 0;
-    }
-
-    updateCollisionCooldowns(deltaTime) {
-        // Update all cooldown timers
-        for (const [bodyId, cooldownTime] of this.collisionCooldowns.entries()) {
-            const newCooldownTime = Math.max(0, cooldownTime - deltaTime);
-            if (newCooldownTime <= 0) {
-                this.collisionCooldowns.delete(bodyId);
-            } else {
-                this.collisionCooldowns.set(bodyId, newCooldownTime);
-            }
-        }
-    }
-
-    clearAllCollisionCooldowns() {
-        this.collisionCooldowns.clear();
-    }
-
     // Validate body state for numerical stability
     validateState() {
         return this.isValidNumber(this.position.x) && 
@@ -509,6 +562,8 @@ class Body {
         // Update radius after mass correction
         this.updateRadius();
         
-        console.warn(`Body ${this.id}: State corrected due to invalid values`);
+        if (Diagnostics.counts[DIAGNOSTIC.BODY_INVALID_STATE]++ === 0) {
+            Diagnostics.sample(DIAGNOSTIC.BODY_INVALID_STATE, `body ${this.id} had non-finite position, velocity or mass`);
+        }
     }
 }
@@ -0,0 +1,357 @@
+/**
+ * Contact islands and sleep management for elastic collisions
+ * Bodies connected through touching contacts form islands. An island whose
+ * members stay at rest relative to each other long enough is put to sleep:
+ * the narrowphase skips pairs inside it and the island moves rigidly under
+ * gravity until something collides with it.
+ */
+
+/**
+ * Union-find over body indices, rebuilt every step
+ */
+class ContactIslands {
+    constructor() {
+        this.parent = new Int32Array(0);
+        this.size = new Int32Array(0);
+        this.count = 0;
+    }
+
+    reset(n) {
+        if (this.parent.length < n) {
+            const capacity = Math.max(n, this.parent.length * 2, 16);
+            this.parent = new Int32Array(capacity);
+            this.size = new Int32Array(capacity);
+        }
+        
+        this.count = n;
+        for (let i = 0; i < n; i++) {
+            this.parent[i] = i;
+            this.size[i] = 1;
+        }
+    }
+
+    find(i) {
+        let root = i;
+        while (this.parent[root] !== root) root = this.parent[root];
+        
+        // Path compression
+        while (this.parent[i] !== root) {
+            const next = this.parent[i];
+            this.parent[i] = root;
+            i = next;
+        }
+        return root;
+    }
+
+    union(a, b) {
+        let rootA = this.find(a);
+        let rootB = this.find(b);
+        if (rootA === rootB) return rootA;
+        
+        // Union by size
+        if (this.size[rootA] < this.size[rootB]) {
+            const swap = rootA;
+            rootA = rootB;
+            rootB = swap;
+        }
+        this.parent[rootB] = rootA;
+        this.size[rootA] += this.size[rootB];
+        return rootA;
+    }
+}
+
+/**
+ * Tracks resting contact islands and puts quiet ones to sleep
+ */
+class SleepManager {
+    constructor() {
+        this.enabled = true;
+        this.velocityThreshold = PHYSICS_CONSTANTS.SLEEP_VELOCITY_THRESHOLD;
+        this.timeToSleep = PHYSICS_CONSTANTS.SLEEP_TIME;
+        this.contactTolerance = PHYSICS_CONSTANTS.SLEEP_CONTACT_TOLERANCE;
+        
+        this.islands = new ContactIslands();
+        
+        // Touching pairs recorded by the narrowphase this step
+        this.contactCapacity = 256;
+        this.contactA = new Int32Array(this.contactCapacity);
+        this.contactB = new Int32Array(this.contactCapacity);
+        this.contactCount = 0;
+        
+        // Per-root scratch, indexed by island root
+        this.rootMass = new Float64Array(0);
+        this.rootMomentumX = new Float64Array(0);
+        this.rootMomentumY = new Float64Array(0);
+        this.rootQuiet = new Uint8Array(0);
+        this.rootMinTimer = new Float64Array(0);
+        this.touched = new Uint8Array(0);
+        
+        this.frame = 0;
+        this.sleepingCount = 0;
+        this.stats = {
+            sleepingBodies: 0,
+            sleepingIslands: 0,
+            skippedPairs: 0,
+            wakeEvents: 0
+        };
+    }
+
+    /**
+     * Start collecting contacts for a new step
+     */
+    beginStep() {
+        this.contactCount = 0;
+        this.stats.skippedPairs = 0;
+    }
+
+    /**
+     * True when the pair lies inside one sleeping island and needs no narrowphase work
+     */
+    canSkipPair(body1, body2) {
+        if (body1.sleeping && body2.sleeping && body1.sleepIsland === body2.sleepIsland) {
+            this.stats.skippedPairs++;
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Remember the pair as an island edge if the bodies are (nearly) touching
+     */
+    recordContact(i, j, body1, body2) {
+        if (!this.enabled || body1.fixed || body2.fixed) return;
+        
+        const dx = body2.position.x - body1.position.x;
+        const dy = body2.position.y - body1.position.y;
+        const reach = (body1.radius + body2.radius) * (1 + this.contactTolerance);
+        if (dx * dx + dy * dy > reach * reach) return;
+        
+        if (this.contactCount >= this.contactCapacity) {
+            this.contactCapacity *= 2;
+            const contactA = new Int32Array(this.contactCapacity);
+            const contactB = new Int32Array(this.contactCapacity);
+            contactA.set(this.contactA);
+            contactB.set(this.contactB);
+            this.contactA = contactA;
+            this.contactB = contactB;
+        }
+        
+        this.contactA[this.contactCount] = i;
+        this.contactB[this.contactCount] = j;
+        this.contactCount++;
+    }
+
+    /**
+     * Group this step's contacts into islands, advance sleep timers and put islands
+     * whose members have all been quiet for timeToSleep to sleep
+     */
+    update(bodies, deltaTime) {
+        const n = bodies.length;
+        this.ensureCapacity(n);
+        this.islands.reset(n);
+        this.touched.fill(0, 0, n);
+        
+        for (let c = 0; c < this.contactCount; c++) {
+            const a = this.contactA[c];
+            const b = this.contactB[c];
+            this.islands.union(a, b);
+            this.touched[a] = 1;
+            this.touched[b] = 1;
+        }
+        
+        // Momentum per island gives its mean velocity
+        for (let i = 0; i < n; i++) {
+            const root = this.islands.find(i);
+            this.rootMass[root] = 0;
+            this.rootMomentumX[root] = 0;
+            this.rootMomentumY[root] = 0;
+            this.rootQuiet[root] = 1;
+            this.rootMinTimer[root] = Infinity;
+        }
+        for (let i = 0; i < n; i++) {
+            if (!this.touched[i]) continue;
+            const body = bodies[i];
+            const root = this.islands.find(i);
+            this.rootMass[root] += body.mass;
+            this.rootMomentumX[root] += body.mass * body.velocity.x;
+            this.rootMomentumY[root] += body.mass * body.velocity.y;
+        }
+        
+        // An island is quiet when no member moves relative to its mean velocity
+        const thresholdSquared = this.velocityThreshold * this.velocityThreshold;
+        for (let i = 0; i < n; i++) {
+            if (!this.touched[i]) continue;
+            const body = bodies[i];
+            const root = this.islands.find(i);
+            const dvx = body.velocity.x - this.rootMomentumX[root] / this.rootMass[root];
+            const dvy = body.velocity.y - this.rootMomentumY[root] / this.rootMass[root];
+            if (dvx * dvx + dvy * dvy > thresholdSquared || body.beingDragged) {
+                this.rootQuiet[root] = 0;
+            }
+        }
+        
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            if (!this.touched[i]) {
+                // Bodies without contacts keep no sleep history
+                if (!body.sleeping) body.sleepTimer = 0;
+                continue;
+            }
+            
+            const root = this.islands.find(i);
+            if (this.rootQuiet[root]) {
+                if (!body.sleeping) body.sleepTimer += deltaTime;
+            } else {
+                body.sleepTimer = 0;
+            }
+            this.rootMinTimer[root] = Math.min(this.rootMinTimer[root], body.sleepTimer);
+        }
+        
+        // Put islands to sleep; islands that absorb an already sleeping island replace it
+        const newIslands = new Map();
+        for (let i = 0; i < n; i++) {
+            if (!this.touched[i]) continue;
+            const root = this.islands.find(i);
+            if (!this.rootQuiet[root] || this.rootMinTimer[root] < this.timeToSleep) continue;
+            
+            const body = bodies[i];
+            let island = newIslands.get(root);
+            if (!island) {
+                island = this.createIsland();
+                newIslands.set(root, island);
+            }
+            if (!body.sleeping) this.sleepingCount++;
+            body.sleeping = true;
+            body.sleepIsland = island;
+            island.members.push(body);
+        }
+        
+        this.updateStats(bodies);
+    }
+
+    createIsland() {
+        return {
+            members: [],
+            frame: -1, // Last frame the accumulators below were reset
+            mass: 0,
+            displacementX: 0,
+            displacementY: 0,
+            momentumX: 0,
+            momentumY: 0,
+            wake: false
+        };
+    }
+
+    /**
+     * Move every sleeping island rigidly with its mass-weighted mean motion, so gravity
+     * still carries it while the members keep their relative configuration.
+     * Call after integration, before collision detection.
+     */
+    constrainSleepingIslands(bodies) {
+        if (this.sleepingCount === 0) return;
+        
+        const frame = ++this.frame;
+        
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (!body.sleeping) continue;
+            
+            const island = body.sleepIsland;
+            if (island.frame !== frame) {
+                island.frame = frame;
+                island.mass = 0;
+                island.displacementX = 0;
+                island.displacementY = 0;
+                island.momentumX = 0;
+                island.momentumY = 0;
+                island.wake = false;
+            }
+            
+            island.mass += body.mass;
+            island.displacementX += body.mass * (body.position.x - body.lastPosition.x);
+            island.displacementY += body.mass * (body.position.y - body.lastPosition.y);
+            island.momentumX += body.mass * body.velocity.x;
+            island.momentumY += body.mass * body.velocity.y;
+            
+            // Anything the user grabs wakes its island
+            if (body.beingDragged || body.fixed) island.wake = true;
+        }
+        
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (!body.sleeping) continue;
+            
+            const island = body.sleepIsland;
+            if (island.wake) {
+                this.wakeIsland(island);
+                continue;
+            }
+            
+            body.position.x = body.lastPosition.x + island.displacementX / island.mass;
+            body.position.y = body.lastPosition.y + island.displacementY / island.mass;
+            body.velocity.x = island.momentumX / island.mass;
+            body.velocity.y = island.momentumY / island.mass;
+        }
+    }
+
+    wakeIsland(island) {
+        if (!island) return;
+        
+        for (const body of island.members) {
+            if (body.sleepIsland !== island) continue;
+            body.sleeping = false;
+            body.sleepTimer = 0;
+            body.sleepIsland = null;
+            this.sleepingCount--;
+        }
+        island.members.length = 0;
+        this.stats.wakeEvents++;
+    }
+
+    wakeAll(bodies) {
+        bodies.forEach(body => {
+            body.sleeping = false;
+            body.sleepTimer = 0;
+            body.sleepIsland = null;
+        });
+        this.sleepingCount = 0;
+        this.updateStats(bodies);
+    }
+
+    updateStats(bodies) {
+        let sleepingBodies = 0;
+        const islands = new Set();
+        for (let i = 0; i < bodies.length; i++) {
+            if (bodies[i].sleeping) {
+                sleepingBodies++;
+                islands.add(bodies[i].sleepIsland);
+            }
+        }
+        
+        // Bodies removed while asleep are no longer counted
+        this.sleepingCount = sleepingBodies;
+        this.stats.sleepingBodies = sleepingBodies;
+        this.stats.sleepingIslands = islands.size;
+    }
+
+    ensureCapacity(n) {
+        if (this.rootMass.length < n) {
+            const capacity = Math.max(n, this.rootMass.length * 2, 16);
+            this.rootMass = new Float64Array(capacity);
+            this.rootMomentumX = new Float64Array(capacity);
+            this.rootMomentumY = new Float64Array(capacity);
+            this.rootQuiet = new Uint8Array(capacity);
+            this.rootMinTimer = new Float64Array(capacity);
+            this.touched = new Uint8Array(capacity);
+        }
+    }
+
+    getStats() {
+        return { ...this.stats };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { ContactIslands, SleepManager };
+}
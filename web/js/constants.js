@@ -25,9 +25,21 @@ const PHYSICS_CONSTANTS = {
     MAX_RESTITUTION: 0.95,  // Cap at 0.95 to prevent infinite energy gain
     COLLISION_FRICTION: 0.1,  // Tangential friction coefficient
     COLLISION_SAFETY_MARGIN: 0.1,  // Small margin to prevent interpenetration
-    COLLISION_COOLDOWN_TIME: 0.25,  // Base cooldown time in seconds
     MAX_VELOCITY_LIMIT: 500,  // Maximum velocity to prevent numerical instability
     
+    // Contact solver
+    CONTACT_VELOCITY_ITERATIONS: 8,  // Maximum impulse iterations per island and step
+    CONTACT_POSITION_ITERATIONS: 3,  // Penetration correction passes per step
+    CONTACT_SLOP: 0.5,  // Allowed overlap before positions are corrected
+    CONTACT_POSITION_CORRECTION: 0.2,  // Fraction of remaining overlap removed per pass
+    CONTACT_RESTITUTION_THRESHOLD: 5.0,  // Closing speed below which contacts do not bounce
+    CONTACT_VELOCITY_TOLERANCE: 0.01,  // An island stops iterating once impulses change velocities less than this
+    
+    // Sleeping contact islands
+    SLEEP_VELOCITY_THRESHOLD: 2.0,  // Relative speed below which a contact island counts as resting
+    SLEEP_TIME: 0.5,  // Seconds an island must rest before it is put to sleep
+    SLEEP_CONTACT_TOLERANCE: 0.25,  // Gap (fraction of radius sum) still treated as touching
+    
     // Body physics properties
     BODY_DENSITY: 1.0,  // Default density for mass-to-radius calculations (kg/unit³)
     
@@ -39,9 +51,50 @@ const PHYSICS_CONSTANTS = {
     // Barnes-Hut algorithm
     BARNES_HUT_THETA: 0.5,
     BARNES_HUT_MAX_BODIES_THRESHOLD: 5,
+    BARNES_HUT_LEAF_CAPACITY: 8,  // Bodies a leaf holds before it is split
+    BARNES_HUT_MIN_CELL_SOFTENING: 0.5,  // Cells smaller than this many softening lengths are not split
+    
+    // Neighbor lists (reused until some body has moved more than half the skin)
+    NEIGHBOR_LIST_SKIN: 10.0,
+    NEAR_FIELD_SOFTENING_RATIO: 2.0,  // Radius of the direct near-field gravity sum, in softening lengths
+    
+    // Multiple time stepping (near field every step, tree far field every few steps)
+    FAR_FIELD_INTERVAL: 4,  // Steps between far-field evaluations
+    FAR_FIELD_MAX_INTERVAL: 16,  // Longest interval the auto-tuner may choose
+    FAR_FIELD_TOLERANCE: 0.02,  // Largest RMS relative change of the far field over one interval
+    MULTIPLE_TIME_STEP_NEAR_RATIO: 4.0,  // Near-field radius while multiple time stepping, in softening lengths
+    MULTIPLE_TIME_STEP_SWITCH_WIDTH: 0.5,  // Outer fraction of that radius over which pairs hand over to the far field
+    
+    // Specialized force kernels
+    KERNEL_CACHE_SIZE: 32,  // Compiled kernels kept; the least recently used is dropped beyond this
+    
+    // Batch insertion
+    BATCH_INSERT_DIRECT_PAIRS: 200000,  // New-body × body pairs summed directly before a tree is built
+    
+    // Escaper archival
+    ESCAPE_RADIUS: 3000,  // Unbound bodies farther than this from the centre of mass leave the active set
+    ESCAPER_CHECK_INTERVAL: 0.25,  // Simulated seconds between escaper scans
+    
+    // Group finding (friends-of-friends)
+    GROUP_LINKING_FACTOR: 0.2,  // Linking length as a fraction of the mean interparticle separation
+    GROUP_MIN_MEMBERS: 10,  // Smaller groups are left out of catalogs
+    GROUP_CATALOG_INTERVAL: 60,  // Physics steps between catalogs
+    GROUP_DIRECT_POTENTIAL_MEMBERS: 512,  // Larger groups are unbound with tree potentials
+    GROUP_UNBIND_PASSES: 5,  // Most passes spent removing unbound members from one group
+    GROUP_EVENT_HISTORY: 50,  // Formation, merger and dissolution events kept
+    
+    // Batch orbital elements
+    ORBIT_SURVEY_INTERVAL: 30,  // Physics steps between orbital-element surveys
+    ORBIT_HISTOGRAM_BINS: 40,  // Bins in the semi-major axis and eccentricity histograms
     
     // Energy calculation precision
-    ENERGY_PRECISION_THRESHOLD: 0.01
+    ENERGY_PRECISION_THRESHOLD: 0.01,
+    DEFERRED_ENERGY_BODY_THRESHOLD: 1000,  // Above this, main-thread potential energy comes from a background audit
+    
+    // Cooperative scheduling of long main-thread jobs
+    SCHEDULER_FRAME_BUDGET: 4,  // Milliseconds of scheduled work per animation frame
+    SCHEDULER_WORKER_SLICE: 12,  // Milliseconds a worker job runs before yielding to step messages
+    SLICED_IMPORT_THRESHOLD: 2000  // Configurations with more bodies than this are imported in slices
 };
 
 // Rendering Constants
@@ -54,11 +107,23 @@ const RENDERING_CONSTANTS = {
     // Trail rendering
     DEFAULT_TRAIL_LENGTH: 50,
     MAX_TRAIL_LENGTH: 1000,
+    TRAIL_SAMPLE_PIXELS: 2, // Screen distance a body moves before its next trail point
+    TRAIL_SAMPLE_WORLD_DISTANCE: 0, // When positive, a fixed world distance used instead of the screen one
+    TRAIL_SAMPLE_ANGLE: 0.1, // Turn (radians) that records a point before the distance is reached
+    TRAIL_FADE_ALPHA: 0.04, // Share of the accumulated trail layer erased each frame
+    TRAIL_REBUILD_BANDS: 4, // Opacity levels used when the trail layer is redrawn from history
+    TRAIL_REBUILD_MAX_POINTS: 500000, // Trail points a redraw of the trail layer may use across all bodies
+    TRAIL_HISTORY_TIERS: 3, // Decimated tiers of history kept behind the full-resolution trail
+    TRAIL_HISTORY_TIER_POINTS: 16, // Points kept per history tier
+    TRAIL_HISTORY_TOLERANCE: 0.01, // First-tier deviation allowed, as a fraction of the replacing segment's length
+    TRAIL_HISTORY_TOLERANCE_GROWTH: 3, // Tolerance factor from one tier to the next (older) one
+    TRAIL_HISTORY_WINDOW: 12, // Most points one history segment may replace
     
     // Camera and zoom
     DEFAULT_ZOOM: 1.0,
     MIN_ZOOM: 0.1,
     MAX_ZOOM: 10.0,
+    ZOOM_SNAP: 0.002, // Relative gap to the target zoom below which the eased zoom snaps to it
     
     // Performance
     MAX_BODIES_FOR_GPU: 1024,
@@ -67,7 +132,58 @@ const RENDERING_CONSTANTS = {
     DEFAULT_PREDICTION_STEPS: 1000,
     MAX_PREDICTION_STEPS: 20000,
     PREDICTION_TIME_STEP: 0.005,
-    MAX_PREDICTION_POINTS: 2000
+    MAX_PREDICTION_POINTS: 2000,
+    
+    // Short-term orbit preview
+    CONIC_PREVIEW_DOMINANCE: 0.9,  // Share of the total pull above which the preview is a two-body conic
+    CONIC_PREVIEW_POINTS: 240,  // Points per preview path
+    CONIC_PREVIEW_MAX_RADIUS: 10,  // Open conics are drawn out to this multiple of the starting distance
+    PREVIEW_INTEGRATION_STEPS: 1500,  // Steps of the multi-body fallback
+    PREVIEW_FIELD_BODIES: 16,  // Heaviest bodies integrated with the preview body in the fallback
+    
+    // Dynamic resolution (scene render scale, as a fraction of the display canvas)
+    RENDER_SCALE_MIN: 0.5,
+    RENDER_SCALE_MAX: 1.0,
+    RENDER_SCALE_STEP: 0.1,  // Scale change per adjustment
+    RENDER_SCALE_TARGET_RENDER_TIME: 8,  // Render cost (ms) the scaler aims for, half a 60 Hz frame
+    RENDER_SCALE_SETTLE_FRAMES: 20,  // Frames after a change before the scale is lowered again
+    RENDER_SCALE_PROBE_FRAMES: 120,  // Frames on target before the scale is raised (doubles after each failed raise)
+    
+    // Frame flight recorder
+    FLIGHT_RECORDER_FRAMES: 4096,  // Frames of phase timings kept in the ring
+    STALL_THRESHOLD: 50,  // Frame interval (ms) that counts as a stall
+    STALL_FRAMES_BEFORE: 120,  // Frames before a stall kept in its capture
+    STALL_FRAMES_AFTER: 30,  // Frames after a stall recorded before the capture is taken
+    STALL_MAX_CAPTURES: 8,  // Oldest captures are dropped beyond this
+    STALL_COOLDOWN_FRAMES: 60,  // Frames after a capture before another stall is captured
+    
+    // Benchmark mode
+    BENCHMARK_SEED: 20240601,  // Seed of the synthetic scenes
+    BENCHMARK_BODY_COUNTS: [1000, 3000, 10000, 30000, 100000],  // Synthetic disc sizes
+    BENCHMARK_DIRECT_MAX_BODIES: 3000,  // Largest scene run with direct summation
+    BENCHMARK_DRIFT_MAX_BODIES: 10000,  // Largest scene whose energy drift is measured (O(N²))
+    BENCHMARK_SIMULATED_DURATION: 3,  // Simulated seconds per run
+    BENCHMARK_WARMUP_FRAMES: 30,  // Frames at the start of a run left out of the statistics
+    BENCHMARK_MAX_RUN_TIME: 30000,  // Wall-clock limit per run (ms); slower runs are reported as truncated
+    BENCHMARK_MAX_FRAMES: 4096,  // Frames sampled per run at most
+    
+    // Memory ledger
+    MEMORY_CHECK_INTERVAL: 5000,  // Milliseconds between measurements (and budget checks)
+    MEMORY_GROWTH_SAMPLES: 60,  // Measurements kept per subsystem for its growth rate
+    MEMORY_OBJECT_BYTES: 48,  // Estimated heap size of one small object (a Vector2D, a history entry)
+    MEMORY_BODY_OBJECTS: 8,  // Objects a Body holds besides its trail (vectors, arrays, maps)
+    MEMORY_SHED_FACTOR: 0.75,  // Share of a trail, history or cache length kept each time load is shed
+    MEMORY_MIN_TRAIL_LENGTH: 10,  // Trails are not shortened below this
+    MEMORY_MIN_ENERGY_HISTORY: 100,  // Energy history entries always kept
+    MEMORY_MIN_GRADIENT_CACHE: 10,  // Gradient cache entries always allowed
+    MEMORY_BUDGETS: {  // Bytes per subsystem before it sheds load; capped ones only trip well past their cap
+        trails: 64 * 1024 * 1024,
+        trailHistory: 32 * 1024 * 1024,
+        energyHistory: 256 * 1024,  // A full 1000-entry history is about 47 KB
+        renderCaches: 64 * 1024,  // 100 cached gradients are about 4.7 KB
+        flightRecorder: 2 * 1024 * 1024,  // The fixed ring is about 590 KB, plus up to about 185 KB of captures
+        kernelCache: 256 * 1024  // KERNEL_CACHE_SIZE kernels are about 56 KB
+    }
 };
 
 // UI Constants
@@ -85,7 +201,12 @@ const UI_CONSTANTS = {
     MIN_MASS: 1,
     MAX_MASS: 10000,
     MIN_VELOCITY: -1000,
-    MAX_VELOCITY: 1000
+    MAX_VELOCITY: 1000,
+    
+    // Shift-drag body spray
+    SPRAY_BODIES_PER_MOVE: 4,  // Bodies queued per mouse move event
+    SPRAY_RADIUS: 25,  // Screen pixels around the cursor
+    SPRAY_MASS_FRACTION: 0.1  // Sprayed bodies get this fraction of the mass slider value
 };
 
 // Real-world scale constants
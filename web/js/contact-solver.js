@@ -0,0 +1,372 @@
+/**
+ * Sequential-impulse contact solver for elastic collisions
+ * Contacts gathered from the broadphase are grouped into independent islands and
+ * each island is solved with accumulated, clamped impulses that are warm-started
+ * from the previous step. Penetration is removed in a separate position pass that
+ * never feeds back into velocity.
+ */
+
+class ContactSolver {
+    constructor() {
+        this.velocityIterations = PHYSICS_CONSTANTS.CONTACT_VELOCITY_ITERATIONS;
+        this.positionIterations = PHYSICS_CONSTANTS.CONTACT_POSITION_ITERATIONS;
+        this.slop = PHYSICS_CONSTANTS.CONTACT_SLOP; // Penetration left alone to keep resting contacts stable
+        this.positionCorrection = PHYSICS_CONSTANTS.CONTACT_POSITION_CORRECTION; // Fraction of penetration removed per position iteration
+        this.restitutionThreshold = PHYSICS_CONSTANTS.CONTACT_RESTITUTION_THRESHOLD; // Closing speed below which contacts do not bounce
+        this.velocityTolerance = PHYSICS_CONSTANTS.CONTACT_VELOCITY_TOLERANCE; // Island stops iterating once no impulse changes velocity more than this
+        this.friction = PHYSICS_CONSTANTS.COLLISION_FRICTION;
+        this.restitution = PHYSICS_CONSTANTS.RESTITUTION_COEFFICIENT;
+        this.timeStep = PHYSICS_CONSTANTS.FIXED_TIME_STEP;
+        this.movedPositions = false; // The last solve's position pass moved some body
+        
+        // Contact list for the current step (structure of arrays)
+        this.capacity = 256;
+        this.count = 0;
+        this.allocateContacts(this.capacity);
+        
+        // Accumulated impulses from the previous step, keyed by body id pair
+        this.impulseCache = new Map();
+        this.nextImpulseCache = new Map();
+        
+        // Island grouping
+        this.islands = new ContactIslands();
+        this.islandStart = new Int32Array(0);
+        this.islandOrder = new Int32Array(0);
+        this.islandCount = 0;
+        
+        // Per-body scratch
+        this.inverseMass = new Float64Array(0);
+        this.inContact = new Uint8Array(0);
+        
+        this.stats = {
+            contacts: 0,
+            islands: 0,
+            warmStarted: 0,
+            averageIterations: 0,
+            solveTime: 0
+        };
+    }
+
+    allocateContacts(capacity) {
+        const grow = (array, Type) => {
+            const next = new Type(capacity);
+            if (array) next.set(array.subarray(0, Math.min(array.length, capacity)));
+            return next;
+        };
+        
+        this.bodyA = grow(this.bodyA, Int32Array);
+        this.bodyB = grow(this.bodyB, Int32Array);
+        this.normalX = grow(this.normalX, Float64Array);
+        this.normalY = grow(this.normalY, Float64Array);
+        this.gap = grow(this.gap, Float64Array); // Distance between surfaces, negative when overlapping
+        this.velocityTarget = grow(this.velocityTarget, Float64Array); // Relative normal velocity the solver aims for
+        this.normalImpulse = grow(this.normalImpulse, Float64Array);
+        this.tangentImpulse = grow(this.tangentImpulse, Float64Array);
+        this.contactKeys = this.contactKeys || [];
+        this.capacity = capacity;
+    }
+
+    /**
+     * Start a new step; deltaTime bounds how far apart a pair may be and still need a contact
+     */
+    beginStep(deltaTime) {
+        this.count = 0;
+        this.timeStep = deltaTime;
+        this.stats.warmStarted = 0;
+    }
+
+    /**
+     * Create a contact for the pair if it touches now or can close its gap within this step.
+     * Returns true when a contact was added.
+     */
+    addCandidate(i, j, body1, body2) {
+        const immovable1 = body1.fixed || body1.beingDragged;
+        const immovable2 = body2.fixed || body2.beingDragged;
+        if (immovable1 && immovable2) return false;
+        
+        const dx = body2.position.x - body1.position.x;
+        const dy = body2.position.y - body1.position.y;
+        const distance = Math.sqrt(dx * dx + dy * dy);
+        const gap = distance - (body1.radius + body2.radius);
+        
+        const normalX = distance > 1e-6 ? dx / distance : 1;
+        const normalY = distance > 1e-6 ? dy / distance : 0;
+        const closingVelocity = (body2.velocity.x - body1.velocity.x) * normalX +
+                                (body2.velocity.y - body1.velocity.y) * normalY;
+        
+        // Speculative contact: far enough apart that no approach this step can reach
+        if (gap > 0 && gap + closingVelocity * this.timeStep > 0) return false;
+        
+        if (this.count >= this.capacity) {
+            this.allocateContacts(this.capacity * 2);
+        }
+        
+        const c = this.count++;
+        this.bodyA[c] = i;
+        this.bodyB[c] = j;
+        this.normalX[c] = normalX;
+        this.normalY[c] = normalY;
+        this.gap[c] = gap;
+        
+        // A separated pair may close its gap but not more; bounce only once touching,
+        // and only on real impacts so slow contacts settle instead of jittering.
+        if (gap > 0) {
+            this.velocityTarget[c] = -gap / this.timeStep;
+        } else if (closingVelocity < -this.restitutionThreshold) {
+            this.velocityTarget[c] = -this.restitution * closingVelocity;
+        } else {
+            this.velocityTarget[c] = 0;
+        }
+        
+        const key = body1.id < body2.id ? body1.id + ':' + body2.id : body2.id + ':' + body1.id;
+        this.contactKeys[c] = key;
+        const cached = this.impulseCache.get(key);
+        if (cached) {
+            this.normalImpulse[c] = cached.normal;
+            this.tangentImpulse[c] = cached.tangent;
+            this.stats.warmStarted++;
+        } else {
+            this.normalImpulse[c] = 0;
+            this.tangentImpulse[c] = 0;
+        }
+        
+        return true;
+    }
+
+    /**
+     * Solve every island of this step's contacts and sync Verlet state with the result
+     */
+    solve(bodies) {
+        const startTime = performance.now();
+        const n = bodies.length;
+        this.ensureBodyCapacity(n);
+        
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            this.inverseMass[i] = body.fixed || body.beingDragged ? 0 : 1 / body.mass;
+            this.inContact[i] = 0;
+        }
+        
+        this.buildIslands(n);
+        this.movedPositions = false;
+        
+        let totalIterations = 0;
+        for (let island = 0; island < this.islandCount; island++) {
+            const start = this.islandStart[island];
+            const end = this.islandStart[island + 1];
+            totalIterations += this.solveIsland(bodies, start, end);
+        }
+        
+        this.storeImpulses();
+        this.syncVerletState(bodies);
+        
+        this.stats.contacts = this.count;
+        this.stats.islands = this.islandCount;
+        this.stats.averageIterations = this.islandCount > 0 ? totalIterations / this.islandCount : 0;
+        this.stats.solveTime = performance.now() - startTime;
+    }
+
+    /**
+     * Group contacts by island (union over movable bodies only, so a fixed body does
+     * not chain everything resting on it into one island) and order them island by island
+     */
+    buildIslands(n) {
+        const count = this.count;
+        this.islands.reset(n);
+        
+        for (let c = 0; c < count; c++) {
+            const a = this.bodyA[c];
+            const b = this.bodyB[c];
+            this.inContact[a] = 1;
+            this.inContact[b] = 1;
+            if (this.inverseMass[a] > 0 && this.inverseMass[b] > 0) {
+                this.islands.union(a, b);
+            }
+        }
+        
+        // Number island roots, then counting sort contacts by island
+        const islandOfRoot = new Int32Array(n).fill(-1);
+        const contactIsland = new Int32Array(count);
+        this.islandCount = 0;
+        for (let c = 0; c < count; c++) {
+            const a = this.bodyA[c];
+            const root = this.islands.find(this.inverseMass[a] > 0 ? a : this.bodyB[c]);
+            if (islandOfRoot[root] < 0) islandOfRoot[root] = this.islandCount++;
+            contactIsland[c] = islandOfRoot[root];
+        }
+        
+        if (this.islandStart.length < this.islandCount + 1) {
+            this.islandStart = new Int32Array(Math.max(this.islandCount + 1, this.islandStart.length * 2));
+        }
+        if (this.islandOrder.length < count) {
+            this.islandOrder = new Int32Array(Math.max(count, this.islandOrder.length * 2));
+        }
+        
+        this.islandStart.fill(0, 0, this.islandCount + 1);
+        for (let c = 0; c < count; c++) {
+            this.islandStart[contactIsland[c] + 1]++;
+        }
+        for (let island = 0; island < this.islandCount; island++) {
+            this.islandStart[island + 1] += this.islandStart[island];
+        }
+        const fill = this.islandStart.slice(0, this.islandCount);
+        for (let c = 0; c < count; c++) {
+            this.islandOrder[fill[contactIsland[c]]++] = c;
+        }
+    }
+
+    /**
+     * Warm start, iterate velocity constraints until converged or out of iterations,
+     * then push overlapping bodies apart. Returns the velocity iterations used.
+     */
+    solveIsland(bodies, start, end) {
+        const order = this.islandOrder;
+        const inverseMass = this.inverseMass;
+        
+        // Warm start with last step's accumulated impulses
+        for (let k = start; k < end; k++) {
+            const c = order[k];
+            const impulseX = this.normalImpulse[c] * this.normalX[c] - this.tangentImpulse[c] * this.normalY[c];
+            const impulseY = this.normalImpulse[c] * this.normalY[c] + this.tangentImpulse[c] * this.normalX[c];
+            this.applyImpulse(bodies, this.bodyA[c], this.bodyB[c], impulseX, impulseY);
+        }
+        
+        let iteration = 0;
+        while (iteration < this.velocityIterations) {
+            iteration++;
+            let maxVelocityChange = 0;
+            
+            for (let k = start; k < end; k++) {
+                const c = order[k];
+                const a = this.bodyA[c];
+                const b = this.bodyB[c];
+                const velocityA = bodies[a].velocity;
+                const velocityB = bodies[b].velocity;
+                const inverseMassSum = inverseMass[a] + inverseMass[b];
+                const normalX = this.normalX[c];
+                const normalY = this.normalY[c];
+                
+                // Friction, bounded by the current normal impulse
+                const tangentVelocity = -(velocityB.x - velocityA.x) * normalY + (velocityB.y - velocityA.y) * normalX;
+                const maxFriction = this.friction * this.normalImpulse[c];
+                const oldTangent = this.tangentImpulse[c];
+                const newTangent = Math.max(-maxFriction, Math.min(maxFriction, oldTangent - tangentVelocity / inverseMassSum));
+                const tangentLambda = newTangent - oldTangent;
+                this.tangentImpulse[c] = newTangent;
+                this.applyImpulse(bodies, a, b, -tangentLambda * normalY, tangentLambda * normalX);
+                
+                // Normal impulse, accumulated and kept non-negative
+                const normalVelocity = (velocityB.x - velocityA.x) * normalX + (velocityB.y - velocityA.y) * normalY;
+                const oldNormal = this.normalImpulse[c];
+                const newNormal = Math.max(0, oldNormal + (this.velocityTarget[c] - normalVelocity) / inverseMassSum);
+                const normalLambda = newNormal - oldNormal;
+                this.normalImpulse[c] = newNormal;
+                this.applyImpulse(bodies, a, b, normalLambda * normalX, normalLambda * normalY);
+                
+                maxVelocityChange = Math.max(maxVelocityChange,
+                    (Math.abs(normalLambda) + Math.abs(tangentLambda)) * inverseMassSum);
+            }
+            
+            if (maxVelocityChange < this.velocityTolerance) break;
+        }
+        
+        // Split position correction: move positions directly so no energy is added
+        for (let pass = 0; pass < this.positionIterations; pass++) {
+            for (let k = start; k < end; k++) {
+                const c = order[k];
+                const a = this.bodyA[c];
+                const b = this.bodyB[c];
+                const bodyA = bodies[a];
+                const bodyB = bodies[b];
+                
+                const dx = bodyB.position.x - bodyA.position.x;
+                const dy = bodyB.position.y - bodyA.position.y;
+                const distance = Math.sqrt(dx * dx + dy * dy);
+                const penetration = bodyA.radius + bodyB.radius - distance - this.slop;
+                if (penetration <= 0) continue;
+                
+                const normalX = distance > 1e-6 ? dx / distance : this.normalX[c];
+                const normalY = distance > 1e-6 ? dy / distance : this.normalY[c];
+                const correction = this.positionCorrection * penetration / (inverseMass[a] + inverseMass[b]);
+                this.movedPositions = true;
+                
+                bodyA.position.x -= correction * inverseMass[a] * normalX;
+                bodyA.position.y -= correction * inverseMass[a] * normalY;
+                bodyB.position.x += correction * inverseMass[b] * normalX;
+                bodyB.position.y += correction * inverseMass[b] * normalY;
+            }
+        }
+        
+        return iteration;
+    }
+
+    applyImpulse(bodies, a, b, impulseX, impulseY) {
+        const velocityA = bodies[a].velocity;
+        const velocityB = bodies[b].velocity;
+        velocityA.x -= impulseX * this.inverseMass[a];
+        velocityA.y -= impulseY * this.inverseMass[a];
+        velocityB.x += impulseX * this.inverseMass[b];
+        velocityB.y += impulseY * this.inverseMass[b];
+    }
+
+    /**
+     * Keep the accumulated impulses of active contacts for next step's warm start
+     */
+    storeImpulses() {
+        const next = this.nextImpulseCache;
+        next.clear();
+        
+        for (let c = 0; c < this.count; c++) {
+            if (this.normalImpulse[c] > 0) {
+                next.set(this.contactKeys[c], {
+                    normal: this.normalImpulse[c],
+                    tangent: this.tangentImpulse[c]
+                });
+            }
+        }
+        
+        this.nextImpulseCache = this.impulseCache;
+        this.impulseCache = next;
+    }
+
+    /**
+     * Verlet derives velocity from the previous position, so rewrite it from the solved
+     * velocity. Position corrections then move both points and add no velocity.
+     */
+    syncVerletState(bodies) {
+        const dt = this.timeStep;
+        
+        for (let i = 0; i < bodies.length; i++) {
+            if (!this.inContact[i] || this.inverseMass[i] === 0) continue;
+            
+            const body = bodies[i];
+            body.lastPosition.x = body.position.x - body.velocity.x * dt;
+            body.lastPosition.y = body.position.y - body.velocity.y * dt;
+        }
+    }
+
+    ensureBodyCapacity(n) {
+        if (this.inverseMass.length < n) {
+            const capacity = Math.max(n, this.inverseMass.length * 2, 16);
+            this.inverseMass = new Float64Array(capacity);
+            this.inContact = new Uint8Array(capacity);
+        }
+    }
+
+    /**
+     * Forget warm-start data, e.g. after the body set was replaced
+     */
+    reset() {
+        this.impulseCache.clear();
+        this.count = 0;
+    }
+
+    getStats() {
+        return { ...this.stats };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { ContactSolver };
+}
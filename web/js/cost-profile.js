@@ -0,0 +1,114 @@
+/**
+ * Per-body cost profile
+ * Counts the work each body causes in the last physics step: tree cells it took as
+ * a single mass, body pairs it summed directly (tree leaves, near-field and direct
+ * sums) and collision candidate pairs it was tested in. Counters live in typed arrays
+ * indexed like the body list, grown as needed and cleared at the start of each step,
+ * so the hot loops only add to an array slot. The renderer colours bodies by the
+ * total and the performance panel shows its distribution, which shows where θ, leaf
+ * capacity and the broadphase cell size actually spend the time.
+ */
+
+class CostProfile {
+    constructor() {
+        this.enabled = false;
+        this.count = 0; // Bodies covered by the current counts
+        this.capacity = 0;
+        this.cellInteractions = new Uint32Array(0); // Tree cells approximated by their centre of mass
+        this.directInteractions = new Uint32Array(0); // Body pairs summed (or examined) directly
+        this.collisionCandidates = new Uint32Array(0); // Broadphase pairs tested
+    }
+
+    /**
+     * Clear the counters for a step over n bodies. Does nothing while disabled, so
+     * callers pass profile.enabled ? profile : null into their loops.
+     */
+    begin(n) {
+        if (!this.enabled) return;
+        
+        if (n > this.capacity) {
+            this.capacity = Math.max(n, Math.ceil(this.capacity * 1.5), 64);
+            this.cellInteractions = new Uint32Array(this.capacity);
+            this.directInteractions = new Uint32Array(this.capacity);
+            this.collisionCandidates = new Uint32Array(this.capacity);
+        } else {
+            this.cellInteractions.fill(0, 0, n);
+            this.directInteractions.fill(0, 0, n);
+            this.collisionCandidates.fill(0, 0, n);
+        }
+        this.count = n;
+    }
+
+    // One count for both bodies of every listed pair
+    addPairs(counters, pairA, pairB, pairCount) {
+        for (let p = 0; p < pairCount; p++) {
+            counters[pairA[p]]++;
+            counters[pairB[p]]++;
+        }
+    }
+
+    getCost(i) {
+        return this.cellInteractions[i] + this.directInteractions[i] + this.collisionCandidates[i];
+    }
+
+    getMaxCost() {
+        let max = 0;
+        for (let i = 0; i < this.count; i++) {
+            max = Math.max(max, this.getCost(i));
+        }
+        return max;
+    }
+
+    /**
+     * Distribution of the total cost in power-of-two bins (bin k holds costs in
+     * [2^k, 2^(k+1)), bin 0 also holds zero), plus the totals per kind. min and max
+     * are the log2 range covered.
+     */
+    getHistogram(bins = 16) {
+        const counts = new Uint32Array(bins);
+        let cells = 0;
+        let direct = 0;
+        let collisions = 0;
+        let max = 0;
+        
+        for (let i = 0; i < this.count; i++) {
+            const cost = this.getCost(i);
+            cells += this.cellInteractions[i];
+            direct += this.directInteractions[i];
+            collisions += this.collisionCandidates[i];
+            max = Math.max(max, cost);
+            counts[Math.min(bins - 1, cost > 1 ? Math.floor(Math.log2(cost)) : 0)]++;
+        }
+        
+        return { min: 0, max: bins, counts, bodies: this.count, maxCost: max, cells, direct, collisions };
+    }
+
+    // Copies of the counters, for posting from the worker
+    snapshot() {
+        if (!this.enabled) return null;
+        return {
+            count: this.count,
+            cellInteractions: this.cellInteractions.slice(0, this.count),
+            directInteractions: this.directInteractions.slice(0, this.count),
+            collisionCandidates: this.collisionCandidates.slice(0, this.count)
+        };
+    }
+
+    load(snapshot) {
+        if (!snapshot) return;
+        this.begin(snapshot.count);
+        this.cellInteractions.set(snapshot.cellInteractions);
+        this.directInteractions.set(snapshot.directInteractions);
+        this.collisionCandidates.set(snapshot.collisionCandidates);
+    }
+
+    setEnabled(enabled) {
+        this.enabled = enabled;
+        if (!enabled) this.count = 0;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { CostProfile };
+}
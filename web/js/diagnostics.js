@@ -0,0 +1,169 @@
+/**
+ * Hot-path diagnostics for CelestialSim
+ * Inner loops record problems by bumping a preallocated counter instead of logging.
+ * The first occurrence of each category keeps a sample message, and the counters
+ * are folded into a report once per second for the performance panel and exports.
+ *
+ * Usage in a hot path:
+ *     if (Diagnostics.counts[DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO]++ === 0) {
+ *         Diagnostics.sample(DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO, 'details');
+ *     }
+ */
+
+// Diagnostic categories (indices into the counter arrays)
+const DIAGNOSTIC = {
+    VECTOR_DIVIDE_BY_ZERO: 0,
+    VECTOR_INVALID_OPERAND: 1,
+    QUADTREE_DEPTH_LIMIT: 2,
+    BODY_INVALID_TIMESTEP: 3,
+    BODY_INVALID_STATE: 4,
+    BODY_NON_FINITE_MASS: 5,
+    PHYSICS_INVALID_NUMBER: 6,
+    PHYSICS_NON_POSITIVE_MASS: 7,
+    INTEGRATOR_STEP_LIMIT: 8,
+    GPU_INVALID_DATA: 9
+};
+
+const DIAGNOSTIC_LABELS = [
+    'Vector division by ~0',
+    'Invalid vector operand',
+    'Quadtree depth limit',
+    'Invalid body timestep',
+    'Invalid body state corrected',
+    'Non-finite body mass',
+    'Invalid physics value',
+    'Non-positive mass',
+    'Integrator step limit',
+    'Invalid GPU data'
+];
+
+class DiagnosticsRegistry {
+    constructor(categoryCount = DIAGNOSTIC_LABELS.length) {
+        this.categoryCount = categoryCount;
+        this.counts = new Int32Array(categoryCount); // Occurrences since the last flush
+        this.totals = new Float64Array(categoryCount); // Occurrences since startup
+        this.samples = new Array(categoryCount).fill(null); // First sample per flush interval
+        this.pendingSamples = []; // Samples not yet handed to another thread
+        this.logToConsole = true; // Log the first occurrence of each category once per session
+        
+        this.lastFlushTime = 0;
+        this.report = this.createEmptyReport();
+    }
+
+    /**
+     * Remember a sample message for a category whose counter just went from 0 to 1
+     */
+    sample(code, message) {
+        const entry = { message: String(message), time: Date.now() };
+        this.samples[code] = entry;
+        this.pendingSamples.push({ code, ...entry });
+        
+        if (this.logToConsole && this.totals[code] === 0) {
+            console.warn(`[diagnostics] ${DIAGNOSTIC_LABELS[code]}: ${entry.message} (further occurrences are counted, not logged)`);
+        }
+    }
+
+    /**
+     * Fold the per-interval counters into the report and start a new interval
+     */
+    flush(now = performance.now()) {
+        const elapsed = this.lastFlushTime > 0 ? (now - this.lastFlushTime) / 1000 : 1;
+        const categories = [];
+        let intervalTotal = 0;
+        
+        for (let code = 0; code < this.categoryCount; code++) {
+            const count = this.counts[code];
+            this.totals[code] += count;
+            intervalTotal += count;
+            
+            if (this.totals[code] > 0) {
+                categories.push({
+                    code,
+                    label: DIAGNOSTIC_LABELS[code],
+                    count,
+                    perSecond: elapsed > 0 ? count / elapsed : count,
+                    total: this.totals[code],
+                    sample: this.samples[code] ? this.samples[code].message : null
+                });
+            }
+            
+            this.counts[code] = 0;
+        }
+        
+        this.lastFlushTime = now;
+        this.pendingSamples = [];
+        this.report = {
+            interval: elapsed,
+            intervalTotal,
+            categories,
+            timestamp: Date.now()
+        };
+        return this.report;
+    }
+
+    /**
+     * Counters and new samples since the previous snapshot, for posting from a worker.
+     * Returns null when nothing happened.
+     */
+    takeSnapshot() {
+        let any = this.pendingSamples.length > 0;
+        for (let code = 0; code < this.categoryCount && !any; code++) {
+            if (this.counts[code] !== 0) any = true;
+        }
+        if (!any) return null;
+        
+        const snapshot = {
+            counts: Array.from(this.counts),
+            samples: this.pendingSamples
+        };
+        for (let code = 0; code < this.categoryCount; code++) {
+            this.totals[code] += this.counts[code];
+            this.counts[code] = 0;
+        }
+        this.pendingSamples = [];
+        return snapshot;
+    }
+
+    /**
+     * Add a snapshot taken in another thread to this registry's current interval
+     */
+    merge(snapshot) {
+        if (!snapshot || !Array.isArray(snapshot.counts)) return;
+        
+        const length = Math.min(snapshot.counts.length, this.categoryCount);
+        for (let code = 0; code < length; code++) {
+            this.counts[code] += snapshot.counts[code] | 0;
+        }
+        if (Array.isArray(snapshot.samples)) {
+            snapshot.samples.forEach(entry => {
+                if (entry && entry.code >= 0 && entry.code < this.categoryCount) {
+                    this.samples[entry.code] = { message: entry.message, time: entry.time };
+                }
+            });
+        }
+    }
+
+    getReport() {
+        return this.report;
+    }
+
+    reset() {
+        this.counts.fill(0);
+        this.totals.fill(0);
+        this.samples.fill(null);
+        this.pendingSamples = [];
+        this.report = this.createEmptyReport();
+    }
+
+    createEmptyReport() {
+        return { interval: 0, intervalTotal: 0, categories: [], timestamp: Date.now() };
+    }
+}
+
+// Global diagnostics registry (one per thread)
+const Diagnostics = new DiagnosticsRegistry();
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { DIAGNOSTIC, DIAGNOSTIC_LABELS, DiagnosticsRegistry, Diagnostics };
+}
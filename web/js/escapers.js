@@ -0,0 +1,334 @@
+/**
+ * Escaper archival
+ * Bodies that have left the system for good stretch the Barnes-Hut root cell and
+ * the collision grid without interacting with anything. Once a body is unbound from
+ * the rest of the system and farther out than the escape radius, it is moved into an
+ * archive and follows the two-body (Kepler) path about the remaining system's centre
+ * of mass instead. Archived bodies keep their Body objects, so they can still be
+ * drawn and saved.
+ */
+
+class EscaperManager {
+    constructor() {
+        this.enabled = false;
+        this.escapeRadius = PHYSICS_CONSTANTS.ESCAPE_RADIUS; // Distance from the centre of mass before a body may be archived
+        this.checkInterval = PHYSICS_CONSTANTS.ESCAPER_CHECK_INTERVAL; // Simulated seconds between escaper scans
+        this.lastCheckTime = -Infinity;
+        
+        this.archive = []; // { body, mu, epoch, x, y, vx, vy, chi }, state relative to the centre at the epoch
+        this.archivedBodies = []; // The archived Body objects, in archive order
+        
+        // Centre of mass of the active system, extrapolated linearly between scans
+        this.centre = { x: 0, y: 0, vx: 0, vy: 0, time: 0, mass: 0 };
+        
+        this.stats = {
+            archivedTotal: 0,
+            lastScanTime: 0
+        };
+    }
+
+    /**
+     * Archive new escapers (at most once per check interval) and move archived bodies
+     * along their paths. Removes archived bodies from `bodies` in place.
+     * `canArchive` is false when the two-body path would be wrong (e.g. inside an
+     * external halo, where no body is ever unbound).
+     */
+    update(bodies, time, gravitationalConstant, canArchive = true) {
+        if (this.enabled && canArchive && time - this.lastCheckTime >= this.checkInterval) {
+            this.lastCheckTime = time;
+            this.scan(bodies, time, gravitationalConstant);
+        }
+        
+        if (this.archive.length > 0) {
+            this.propagate(time);
+        }
+    }
+
+    /**
+     * One O(N) pass for the system's mass, centre of mass and mean velocity, then a
+     * second pass testing each body against the system with that body taken out
+     */
+    scan(bodies, time, gravitationalConstant) {
+        const startTime = performance.now();
+        const n = bodies.length;
+        
+        let mass = 0;
+        let mx = 0;
+        let my = 0;
+        let mvx = 0;
+        let mvy = 0;
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            mass += body.mass;
+            mx += body.mass * body.position.x;
+            my += body.mass * body.position.y;
+            mvx += body.mass * body.velocity.x;
+            mvy += body.mass * body.velocity.y;
+        }
+        if (mass <= 0) return;
+        
+        const escapeRadiusSquared = this.escapeRadius * this.escapeRadius;
+        let kept = 0;
+        
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            const restMass = mass - body.mass;
+            let escaping = false;
+            
+            if (restMass > 0 && !body.fixed && !body.beingDragged && !body.selected) {
+                // Centre of mass and velocity of everything else
+                const cx = (mx - body.mass * body.position.x) / restMass;
+                const cy = (my - body.mass * body.position.y) / restMass;
+                const dx = body.position.x - cx;
+                const dy = body.position.y - cy;
+                const distanceSquared = dx * dx + dy * dy;
+                
+                if (distanceSquared > escapeRadiusSquared) {
+                    const dvx = body.velocity.x - (mvx - body.mass * body.velocity.x) / restMass;
+                    const dvy = body.velocity.y - (mvy - body.mass * body.velocity.y) / restMass;
+                    const mu = gravitationalConstant * restMass;
+                    
+                    // Outbound with positive specific orbital energy: the body never comes back
+                    if (dx * dvx + dy * dvy > 0 &&
+                        0.5 * (dvx * dvx + dvy * dvy) - mu / Math.sqrt(distanceSquared) > 0) {
+                        escaping = true;
+                        mass = restMass;
+                        mx -= body.mass * body.position.x;
+                        my -= body.mass * body.position.y;
+                        mvx -= body.mass * body.velocity.x;
+                        mvy -= body.mass * body.velocity.y;
+                        this.archiveBody(body, mu, time, dx, dy, dvx, dvy);
+                    }
+                }
+            }
+            
+            if (!escaping) {
+                bodies[kept++] = body;
+            }
+        }
+        bodies.length = kept;
+        
+        this.centre.x = mx / mass;
+        this.centre.y = my / mass;
+        this.centre.vx = mvx / mass;
+        this.centre.vy = mvy / mass;
+        this.centre.time = time;
+        this.centre.mass = mass;
+        
+        this.stats.lastScanTime = performance.now() - startTime;
+    }
+
+    archiveBody(body, mu, time, x, y, vx, vy) {
+        body.resetForce();
+        body.hasCollidedThisFrame = false;
+        this.archive.push({ body, mu, epoch: time, x, y, vx, vy, chi: 0 });
+        this.archivedBodies.push(body);
+        this.stats.archivedTotal++;
+    }
+
+    /**
+     * Place every archived body on its analytic path at `time`. Each path is solved
+     * from its archive epoch, so no error accumulates however long it runs.
+     */
+    propagate(time) {
+        const centre = this.centre;
+        const elapsed = time - centre.time;
+        const cx = centre.x + centre.vx * elapsed;
+        const cy = centre.y + centre.vy * elapsed;
+        
+        for (let i = 0; i < this.archive.length; i++) {
+            const entry = this.archive[i];
+            const body = entry.body;
+            const state = EscaperManager.keplerState(entry, time - entry.epoch);
+            
+            body.position.x = cx + state.x;
+            body.position.y = cy + state.y;
+            body.velocity.x = centre.vx + state.vx;
+            body.velocity.y = centre.vy + state.vy;
+            body.lastPosition.x = body.position.x;
+            body.lastPosition.y = body.position.y;
+            body.sampleTrail(time);
+        }
+    }
+
+    /**
+     * Two-body state after dt, using universal variables so elliptic, parabolic and
+     * hyperbolic paths share one solver. entry.chi carries the last solution as the
+     * next Newton starting guess.
+     */
+    static keplerState(entry, dt) {
+        const mu = entry.mu;
+        const sqrtMu = Math.sqrt(mu);
+        const r0 = Math.sqrt(entry.x * entry.x + entry.y * entry.y);
+        const radialVelocity = (entry.x * entry.vx + entry.y * entry.vy) / r0;
+        const alpha = 2 / r0 - (entry.vx * entry.vx + entry.vy * entry.vy) / mu; // Reciprocal semi-major axis
+        
+        let chi = entry.chi;
+        if (chi === 0 && dt !== 0) {
+            // Starting guesses from Vallado; a linear guess overflows cosh on long hyperbolic arcs
+            if (alpha > 1e-9) {
+                chi = sqrtMu * dt * alpha;
+            } else if (alpha < -1e-9) {
+                const a = 1 / alpha;
+                const sign = Math.sign(dt);
+                const rDotV = entry.x * entry.vx + entry.y * entry.vy;
+                chi = sign * Math.sqrt(-a) * Math.log((-2 * mu * alpha * dt) /
+                    (rDotV + sign * Math.sqrt(-mu * a) * (1 - r0 * alpha)));
+            } else {
+                chi = sqrtMu * dt / r0;
+            }
+        }
+        
+        let c = 0.5;
+        let s = 1 / 6;
+        for (let iteration = 0; iteration < 50; iteration++) {
+            const z = alpha * chi * chi;
+            c = EscaperManager.stumpffC(z);
+            s = EscaperManager.stumpffS(z);
+            
+            const chi2 = chi * chi;
+            const f = r0 * radialVelocity / sqrtMu * chi2 * c +
+                (1 - alpha * r0) * chi2 * chi * s + r0 * chi - sqrtMu * dt;
+            const derivative = r0 * radialVelocity / sqrtMu * chi * (1 - z * s) +
+                (1 - alpha * r0) * chi2 * c + r0;
+            const step = f / derivative;
+            chi -= step;
+            if (Math.abs(step) <= 1e-12 * Math.max(1, Math.abs(chi))) break;
+        }
+        entry.chi = chi;
+        
+        const z = alpha * chi * chi;
+        c = EscaperManager.stumpffC(z);
+        s = EscaperManager.stumpffS(z);
+        const chi2 = chi * chi;
+        
+        // Lagrange coefficients
+        const f = 1 - chi2 / r0 * c;
+        const g = dt - chi2 * chi / sqrtMu * s;
+        const x = f * entry.x + g * entry.vx;
+        const y = f * entry.y + g * entry.vy;
+        const r = Math.sqrt(x * x + y * y);
+        const fDot = sqrtMu / (r * r0) * (alpha * chi2 * chi * s - chi);
+        const gDot = 1 - chi2 / r * c;
+        
+        return {
+            x,
+            y,
+            vx: fDot * entry.x + gDot * entry.vx,
+            vy: fDot * entry.y + gDot * entry.vy
+        };
+    }
+
+    static stumpffC(z) {
+        if (z > 1e-8) return (1 - Math.cos(Math.sqrt(z))) / z;
+        if (z < -1e-8) return (Math.cosh(Math.sqrt(-z)) - 1) / -z;
+        return 0.5 - z / 24;
+    }
+
+    static stumpffS(z) {
+        if (z > 1e-8) {
+            const root = Math.sqrt(z);
+            return (root - Math.sin(root)) / (z * root);
+        }
+        if (z < -1e-8) {
+            const root = Math.sqrt(-z);
+            return (Math.sinh(root) - root) / (-z * root);
+        }
+        return 1 / 6 - z / 120;
+    }
+
+    /**
+     * Drop a body from the archive (the caller decides whether it rejoins the simulation)
+     */
+    remove(body) {
+        const index = this.archivedBodies.indexOf(body);
+        if (index < 0) return false;
+        
+        this.archive.splice(index, 1);
+        this.archivedBodies.splice(index, 1);
+        return true;
+    }
+
+    getArchivedBodies() {
+        return this.archivedBodies;
+    }
+
+    hasArchivedBodies() {
+        return this.archive.length > 0;
+    }
+
+    clear() {
+        this.archive = [];
+        this.archivedBodies = [];
+        this.lastCheckTime = -Infinity;
+    }
+
+    /**
+     * Archive contents for saving. Paths keep their epoch state, with times stored as
+     * ages so a reload continues them from whatever the new simulation time is.
+     */
+    serialize(time) {
+        return {
+            centre: { ...this.centre, age: time - this.centre.time },
+            entries: this.archive.map(entry => ({
+                body: entry.body.toJSON(),
+                mu: entry.mu,
+                age: time - entry.epoch,
+                x: entry.x,
+                y: entry.y,
+                vx: entry.vx,
+                vy: entry.vy
+            }))
+        };
+    }
+
+    load(data, time) {
+        this.clear();
+        if (!data || !Array.isArray(data.entries)) return;
+        
+        if (data.centre) {
+            this.centre.x = data.centre.x || 0;
+            this.centre.y = data.centre.y || 0;
+            this.centre.vx = data.centre.vx || 0;
+            this.centre.vy = data.centre.vy || 0;
+            this.centre.mass = data.centre.mass || 0;
+            this.centre.time = time - (data.centre.age || 0);
+        }
+        data.entries.forEach(entry => {
+            if (!entry || !entry.body || !(entry.mu > 0)) return;
+            const body = Body.fromJSON(entry.body);
+            this.archive.push({
+                body,
+                mu: entry.mu,
+                epoch: time - (entry.age || 0),
+                x: entry.x,
+                y: entry.y,
+                vx: entry.vx,
+                vy: entry.vy,
+                chi: 0
+            });
+            this.archivedBodies.push(body);
+        });
+    }
+
+    // Memory for the ledger: the archive records (the archived bodies count as bodies)
+    getMemoryUsage() {
+        const objects = this.archive.length;
+        return { bytes: objects * (RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES + 8 * 8), objects }; // Eight fields each
+    }
+
+    getStats() {
+        return {
+            enabled: this.enabled,
+            archived: this.archive.length,
+            archivedTotal: this.stats.archivedTotal,
+            lastScanTime: this.stats.lastScanTime,
+            escapeRadius: this.escapeRadius
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { EscaperManager };
+}
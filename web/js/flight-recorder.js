@@ -0,0 +1,286 @@
+/**
+ * Frame flight recorder
+ * Per-frame phase timings for the last few thousand frames, kept in preallocated
+ * columns so that recording a frame is a handful of array stores. A frame that starts
+ * more than the stall threshold after the previous one is a stall: once a few more
+ * frames have been recorded, the window around it is copied out of the ring together
+ * with the body count and configuration taken when it was detected. Long tasks the
+ * browser reports are added to the frame in which they are delivered.
+ *
+ * Timings that arrive between frames (worker results, long tasks) accumulate into the
+ * next frame recorded. With the worker stepping, the physics phases of a frame are
+ * the worker's figures for the result that arrived in it.
+ */
+
+// Recorded phases (column indices). Milliseconds, except steps and bodies.
+const FRAME_PHASE = {
+    INTERVAL: 0, // Since the previous frame began
+    WORK: 1, // From beginFrame to endFrame
+    PHYSICS: 2,
+    STEPS: 3, // Physics substeps
+    TREE_BUILD: 4,
+    TREE_WALK: 5,
+    COLLISIONS: 6,
+    RENDER: 7,
+    RENDER_TRAILS: 8,
+    RENDER_BODIES: 9,
+    RENDER_OVERLAY: 10,
+    UI: 11,
+    WORKER_POST: 12, // Serializing and posting a worker step
+    WORKER_WAIT: 13, // Round trip of the worker step that arrived
+    BACKGROUND: 14, // Scheduler jobs
+    LONG_TASKS: 15,
+    BODIES: 16
+};
+
+const FRAME_PHASE_NAMES = [
+    'interval', 'work', 'physics', 'steps', 'treeBuild', 'treeWalk', 'collisions',
+    'render', 'renderTrails', 'renderBodies', 'renderOverlay', 'ui',
+    'workerPost', 'workerWait', 'background', 'longTasks', 'bodies'
+];
+
+class FlightRecorder {
+    constructor(capacity = RENDERING_CONSTANTS.FLIGHT_RECORDER_FRAMES) {
+        this.capacity = capacity;
+        this.columns = FRAME_PHASE_NAMES.map(() => new Float64Array(capacity)); // One ring per phase
+        this.frameStart = new Float64Array(capacity); // performance.now() at each frame's start
+        this.current = new Float64Array(FRAME_PHASE_NAMES.length); // The frame being recorded
+        this.currentStart = 0;
+        this.lastFrameStart = 0; // Zero after a pause, so the gap is not counted as a stall
+        this.frameNumber = 0; // Frames recorded so far; frame k sits at slot k % capacity
+        this.enabled = true;
+        
+        // Stall capture
+        this.stallThreshold = RENDERING_CONSTANTS.STALL_THRESHOLD;
+        this.framesBefore = Math.min(RENDERING_CONSTANTS.STALL_FRAMES_BEFORE, capacity - 1);
+        this.framesAfter = Math.min(RENDERING_CONSTANTS.STALL_FRAMES_AFTER, capacity - 1 - this.framesBefore);
+        this.maxCaptures = RENDERING_CONSTANTS.STALL_MAX_CAPTURES;
+        this.cooldownFrames = RENDERING_CONSTANTS.STALL_COOLDOWN_FRAMES;
+        this.pendingStall = null; // Detected stall waiting for its following frames
+        this.nextCaptureFrame = 0; // No new stall is captured before this frame
+        this.captures = []; // Oldest first
+        this.stallCount = 0; // Including stalls inside another's window or cooldown
+        
+        // Long tasks: { frame, start, duration, name }, the most recent maxLongTasks
+        this.longTasks = [];
+        this.maxLongTasks = 256;
+        this.observer = null;
+        this.longTasksSupported = false;
+        this.visibilityHandler = null;
+    }
+
+    /**
+     * Subscribe to long-task entries and to page visibility (rAF stops while the page is
+     * hidden). Missing browser support only leaves the long-task column at zero.
+     */
+    start() {
+        if (typeof PerformanceObserver !== 'undefined' &&
+            Array.isArray(PerformanceObserver.supportedEntryTypes) &&
+            PerformanceObserver.supportedEntryTypes.includes('longtask')) {
+            this.observer = new PerformanceObserver(list => {
+                list.getEntries().forEach(entry => this.addLongTask(entry));
+            });
+            this.observer.observe({ type: 'longtask' });
+            this.longTasksSupported = true;
+        }
+        
+        if (typeof document !== 'undefined') {
+            this.visibilityHandler = () => { this.lastFrameStart = 0; };
+            document.addEventListener('visibilitychange', this.visibilityHandler);
+        }
+    }
+
+    stop() {
+        if (this.observer) {
+            this.observer.disconnect();
+            this.observer = null;
+        }
+        if (this.visibilityHandler) {
+            document.removeEventListener('visibilitychange', this.visibilityHandler);
+            this.visibilityHandler = null;
+        }
+    }
+
+    addLongTask(entry) {
+        this.current[FRAME_PHASE.LONG_TASKS] += entry.duration;
+        this.longTasks.push({
+            frame: this.frameNumber,
+            start: entry.startTime,
+            duration: entry.duration,
+            name: entry.name
+        });
+        if (this.longTasks.length > this.maxLongTasks) {
+            this.longTasks.shift();
+        }
+    }
+
+    beginFrame(now) {
+        this.current[FRAME_PHASE.INTERVAL] = this.lastFrameStart > 0 ? now - this.lastFrameStart : 0;
+        this.currentStart = now;
+        this.lastFrameStart = now;
+    }
+
+    add(phase, value) {
+        this.current[phase] += value;
+    }
+
+    set(phase, value) {
+        this.current[phase] = value;
+    }
+
+    // Value recorded so far for the frame in progress
+    get(phase) {
+        return this.current[phase];
+    }
+
+    /**
+     * Store the frame in the ring and check it for a stall. getContext() describes the
+     * simulation (body count, configuration) and is only called when a stall is found.
+     */
+    endFrame(now, getContext = null) {
+        const current = this.current;
+        if (!this.enabled) {
+            current.fill(0);
+            return;
+        }
+        
+        current[FRAME_PHASE.WORK] = now - this.currentStart;
+        const frame = this.frameNumber;
+        const slot = frame % this.capacity;
+        for (let phase = 0; phase < current.length; phase++) {
+            this.columns[phase][slot] = current[phase];
+        }
+        this.frameStart[slot] = this.currentStart;
+        
+        const interval = current[FRAME_PHASE.INTERVAL];
+        current.fill(0);
+        this.frameNumber++;
+        
+        if (interval > this.stallThreshold) {
+            this.stallCount++;
+            if (!this.pendingStall && frame >= this.nextCaptureFrame) {
+                this.pendingStall = {
+                    frame,
+                    interval,
+                    time: new Date().toISOString(),
+                    context: getContext ? getContext() : null
+                };
+            }
+        }
+        
+        if (this.pendingStall && frame - this.pendingStall.frame >= this.framesAfter) {
+            this.capture(this.pendingStall);
+            this.pendingStall = null;
+            this.nextCaptureFrame = this.frameNumber + this.cooldownFrames;
+        }
+    }
+
+    capture(stall) {
+        const first = Math.max(stall.frame - this.framesBefore, this.frameNumber - this.capacity);
+        const last = this.frameNumber - 1;
+        
+        this.captures.push({
+            time: stall.time,
+            frame: stall.frame,
+            interval: stall.interval,
+            threshold: this.stallThreshold,
+            context: stall.context,
+            window: this.readFrames(first, last),
+            longTasks: this.longTasks.filter(task => task.frame >= first && task.frame <= last + 1)
+        });
+        if (this.captures.length > this.maxCaptures) {
+            this.captures.shift();
+        }
+    }
+
+    /**
+     * Frames first..last (inclusive, still in the ring) as plain arrays per phase
+     */
+    readFrames(first, last) {
+        first = Math.max(first, this.frameNumber - this.capacity, 0);
+        last = Math.min(last, this.frameNumber - 1);
+        const count = Math.max(0, last - first + 1);
+        
+        const window = { firstFrame: first, frameCount: count, start: new Array(count) };
+        FRAME_PHASE_NAMES.forEach(name => { window[name] = new Array(count); });
+        
+        for (let k = 0; k < count; k++) {
+            const slot = (first + k) % this.capacity;
+            window.start[k] = this.frameStart[slot];
+            for (let phase = 0; phase < FRAME_PHASE_NAMES.length; phase++) {
+                window[FRAME_PHASE_NAMES[phase]][k] = this.columns[phase][slot];
+            }
+        }
+        return window;
+    }
+
+    /**
+     * Everything for a download: the stall captures, the whole ring and the long tasks
+     */
+    getDump(context = null) {
+        return {
+            version: '1.0',
+            time: new Date().toISOString(),
+            userAgent: typeof navigator !== 'undefined' ? navigator.userAgent : null,
+            stallThreshold: this.stallThreshold,
+            stallCount: this.stallCount,
+            longTasksSupported: this.longTasksSupported,
+            phases: FRAME_PHASE_NAMES,
+            context,
+            captures: this.captures,
+            recent: this.readFrames(this.frameNumber - this.capacity, this.frameNumber - 1),
+            longTasks: this.longTasks
+        };
+    }
+
+    // The ring columns plus an estimate for the captures and long-task records
+    getMemoryUsage() {
+        let bytes = this.frameStart.byteLength + this.current.byteLength;
+        this.columns.forEach(column => { bytes += column.byteLength; });
+        
+        let objects = this.longTasks.length;
+        for (const capture of this.captures) {
+            objects += 1 + capture.longTasks.length;
+            bytes += capture.window.frameCount * (FRAME_PHASE_NAMES.length + 1) * 8;
+        }
+        return { bytes: bytes + objects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES, objects };
+    }
+
+    /**
+     * Budget shedding: keep fewer stall captures and long tasks from now on, dropping
+     * the oldest. The ring itself is fixed and never shed.
+     */
+    shedCaptures() {
+        const factor = RENDERING_CONSTANTS.MEMORY_SHED_FACTOR;
+        if (this.maxCaptures <= 1 && this.maxLongTasks <= 1) return false;
+        
+        this.maxCaptures = Math.max(1, Math.floor(this.maxCaptures * factor));
+        this.maxLongTasks = Math.max(1, Math.floor(this.maxLongTasks * factor));
+        this.captures.splice(0, Math.max(0, this.captures.length - this.maxCaptures));
+        this.longTasks.splice(0, Math.max(0, this.longTasks.length - this.maxLongTasks));
+        return true;
+    }
+
+    setEnabled(enabled) {
+        this.enabled = enabled;
+        this.pendingStall = null;
+        this.lastFrameStart = 0;
+    }
+
+    getStats() {
+        const lastCapture = this.captures.length > 0 ? this.captures[this.captures.length - 1] : null;
+        return {
+            enabled: this.enabled,
+            frames: Math.min(this.frameNumber, this.capacity),
+            stalls: this.stallCount,
+            captures: this.captures.length,
+            lastStall: lastCapture ? { interval: lastCapture.interval, time: lastCapture.time } : null,
+            longTasks: this.longTasksSupported ? this.longTasks.length : null
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { FRAME_PHASE, FRAME_PHASE_NAMES, FlightRecorder };
+}
@@ -0,0 +1,289 @@
+/**
+ * External force fields
+ * Fields are declared once as plain specs (so they can be saved and sent to the
+ * physics worker) and compiled into packed type/parameter arrays. The engine adds
+ * them to each body's force in the same loop that applies the gravity result, with
+ * no per-body allocations.
+ *
+ * Spec examples:
+ *     { type: 'uniform', gx: 0, gy: 9.8 }
+ *     { type: 'drag', coefficient: 0.05 }
+ *     { type: 'logarithmic-halo', x: 0, y: 0, velocity: 60, coreRadius: 80 }
+ *     { type: 'nfw-halo', x: 0, y: 0, mass: 5000, scaleRadius: 150 }
+ *     { type: 'rotating-frame', x: 0, y: 0, omega: 0.1 }
+ */
+
+const FORCE_FIELD_TYPE = {
+    UNIFORM: 'uniform',                    // Constant acceleration (gx, gy)
+    DRAG: 'drag',                          // Linear drag, a = -coefficient * v
+    LOGARITHMIC_HALO: 'logarithmic-halo',  // Φ = ½ v0² ln(r² + rc²), flat rotation curve
+    NFW_HALO: 'nfw-halo',                  // Φ = -G Ms ln(1 + r/rs) / r
+    ROTATING_FRAME: 'rotating-frame'       // Coriolis and centrifugal terms for a frame turning at omega
+};
+
+// Packed type codes, in FORCE_FIELD_TYPE order
+const FORCE_FIELD_CODES = [
+    FORCE_FIELD_TYPE.UNIFORM,
+    FORCE_FIELD_TYPE.DRAG,
+    FORCE_FIELD_TYPE.LOGARITHMIC_HALO,
+    FORCE_FIELD_TYPE.NFW_HALO,
+    FORCE_FIELD_TYPE.ROTATING_FRAME
+];
+
+const FORCE_FIELD_STRIDE = 4; // Parameters per field in the packed array
+
+class ForceFieldSet {
+    constructor() {
+        this.specs = [];                    // Normalized specs, as declared
+        this.count = 0;                     // Number of compiled fields
+        this.types = new Uint8Array(0);     // Type code per field
+        this.params = new Float64Array(0);  // FORCE_FIELD_STRIDE parameters per field
+    }
+
+    /**
+     * Replace all fields. Invalid specs throw, leaving the current fields in place.
+     */
+    setFields(specs) {
+        const normalized = (specs || []).map(spec => ForceFieldSet.normalize(spec));
+        this.specs = normalized;
+        this.compile();
+    }
+
+    hasFields() {
+        return this.count > 0;
+    }
+
+    /**
+     * Plain copies of the specs, for saving or posting to the worker
+     */
+    toJSON() {
+        return this.specs.map(spec => ({ ...spec }));
+    }
+
+    static normalize(spec) {
+        if (!spec || FORCE_FIELD_CODES.indexOf(spec.type) < 0) {
+            throw new Error(`Unknown force field type: ${spec && spec.type}`);
+        }
+        
+        const number = (value, fallback) => {
+            const result = value === undefined ? fallback : Number(value);
+            if (!isFinite(result)) {
+                throw new Error(`Invalid ${spec.type} force field parameter: ${value}`);
+            }
+            return result;
+        };
+        
+        switch (spec.type) {
+            case FORCE_FIELD_TYPE.UNIFORM:
+                return { type: spec.type, gx: number(spec.gx, 0), gy: number(spec.gy, 0) };
+            case FORCE_FIELD_TYPE.DRAG:
+                return { type: spec.type, coefficient: Math.max(0, number(spec.coefficient, 0)) };
+            case FORCE_FIELD_TYPE.LOGARITHMIC_HALO:
+                return {
+                    type: spec.type,
+                    x: number(spec.x, 0),
+                    y: number(spec.y, 0),
+                    velocity: number(spec.velocity, 0),
+                    coreRadius: Math.max(1e-6, number(spec.coreRadius, 1))
+                };
+            case FORCE_FIELD_TYPE.NFW_HALO:
+                return {
+                    type: spec.type,
+                    x: number(spec.x, 0),
+                    y: number(spec.y, 0),
+                    mass: Math.max(0, number(spec.mass, 0)),
+                    scaleRadius: Math.max(1e-6, number(spec.scaleRadius, 1))
+                };
+            case FORCE_FIELD_TYPE.ROTATING_FRAME:
+                return { type: spec.type, x: number(spec.x, 0), y: number(spec.y, 0), omega: number(spec.omega, 0) };
+        }
+    }
+
+    /**
+     * Pack the specs into typed arrays for the per-body loop
+     */
+    compile() {
+        const count = this.specs.length;
+        this.count = count;
+        this.types = new Uint8Array(count);
+        this.params = new Float64Array(count * FORCE_FIELD_STRIDE);
+        
+        this.specs.forEach((spec, f) => {
+            const code = FORCE_FIELD_CODES.indexOf(spec.type);
+            const p = f * FORCE_FIELD_STRIDE;
+            this.types[f] = code;
+            
+            switch (spec.type) {
+                case FORCE_FIELD_TYPE.UNIFORM:
+                    this.params[p] = spec.gx;
+                    this.params[p + 1] = spec.gy;
+                    break;
+                case FORCE_FIELD_TYPE.DRAG:
+                    this.params[p] = spec.coefficient;
+                    break;
+                case FORCE_FIELD_TYPE.LOGARITHMIC_HALO:
+                    this.params[p] = spec.x;
+                    this.params[p + 1] = spec.y;
+                    this.params[p + 2] = spec.velocity * spec.velocity;
+                    this.params[p + 3] = spec.coreRadius * spec.coreRadius;
+                    break;
+                case FORCE_FIELD_TYPE.NFW_HALO:
+                    this.params[p] = spec.x;
+                    this.params[p + 1] = spec.y;
+                    this.params[p + 2] = spec.mass;
+                    this.params[p + 3] = spec.scaleRadius;
+                    break;
+                case FORCE_FIELD_TYPE.ROTATING_FRAME:
+                    this.params[p] = spec.x;
+                    this.params[p + 1] = spec.y;
+                    this.params[p + 2] = spec.omega;
+                    break;
+            }
+        });
+    }
+
+    /**
+     * Add the field force on one body to body.force.
+     * Called from the engine's force-application loop, so it must not allocate.
+     */
+    accumulate(body, gravitationalConstant) {
+        const x = body.position.x;
+        const y = body.position.y;
+        const vx = body.velocity.x;
+        const vy = body.velocity.y;
+        const types = this.types;
+        const params = this.params;
+        let ax = 0;
+        let ay = 0;
+        
+        for (let f = 0, p = 0; f < this.count; f++, p += FORCE_FIELD_STRIDE) {
+            switch (types[f]) {
+                case 0: // Uniform
+                    ax += params[p];
+                    ay += params[p + 1];
+                    break;
+                
+                case 1: // Linear drag
+                    ax -= params[p] * vx;
+                    ay -= params[p] * vy;
+                    break;
+                
+                case 2: { // Logarithmic halo: a = -v0² r / (r² + rc²)
+                    const dx = x - params[p];
+                    const dy = y - params[p + 1];
+                    const scale = params[p + 2] / (dx * dx + dy * dy + params[p + 3]);
+                    ax -= dx * scale;
+                    ay -= dy * scale;
+                    break;
+                }
+                
+                case 3: { // NFW halo: a = -G M(<r) r̂ / r², M(<r) = Ms [ln(1+s) - s/(1+s)], s = r/rs
+                    const dx = x - params[p];
+                    const dy = y - params[p + 1];
+                    const r = Math.sqrt(dx * dx + dy * dy);
+                    if (r < 1e-9) break;
+                    const s = r / params[p + 3];
+                    const enclosed = s < 1e-4
+                        ? params[p + 2] * s * s * 0.5 // Series limit avoids cancellation near the centre
+                        : params[p + 2] * (Math.log1p(s) - s / (1 + s));
+                    const scale = gravitationalConstant * enclosed / (r * r * r);
+                    ax -= dx * scale;
+                    ay -= dy * scale;
+                    break;
+                }
+                
+                case 4: { // Rotating frame: Coriolis -2Ω×v plus centrifugal Ω²r
+                    const omega = params[p + 2];
+                    ax += 2 * omega * vy + omega * omega * (x - params[p]);
+                    ay += -2 * omega * vx + omega * omega * (y - params[p + 1]);
+                    break;
+                }
+            }
+        }
+        
+        body.force.x += ax * body.mass;
+        body.force.y += ay * body.mass;
+    }
+
+    /**
+     * Add the field forces to every body (for force passes without their own apply loop)
+     */
+    applyToBodies(bodies, gravitationalConstant) {
+        if (this.count === 0) return;
+        
+        for (let i = 0; i < bodies.length; i++) {
+            if (!bodies[i].fixed) this.accumulate(bodies[i], gravitationalConstant);
+        }
+    }
+
+    /**
+     * Potential energy of the bodies in the conservative fields (uniform, halos and the
+     * centrifugal term); drag and Coriolis forces do not have one
+     */
+    potentialEnergy(bodies, gravitationalConstant) {
+        if (this.count === 0) return 0;
+        
+        const params = this.params;
+        let energy = 0;
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            const x = body.position.x;
+            const y = body.position.y;
+            let phi = 0;
+            
+            for (let f = 0, p = 0; f < this.count; f++, p += FORCE_FIELD_STRIDE) {
+                switch (this.types[f]) {
+                    case 0:
+                        phi -= params[p] * x + params[p + 1] * y;
+                        break;
+                    case 2: {
+                        const dx = x - params[p];
+                        const dy = y - params[p + 1];
+                        phi += 0.5 * params[p + 2] * Math.log(dx * dx + dy * dy + params[p + 3]);
+                        break;
+                    }
+                    case 3: {
+                        const dx = x - params[p];
+                        const dy = y - params[p + 1];
+                        const r = Math.sqrt(dx * dx + dy * dy);
+                        const s = r / params[p + 3];
+                        // Limit at r = 0 is -G Ms / rs
+                        phi -= gravitationalConstant * params[p + 2] *
+                            (s < 1e-9 ? 1 / params[p + 3] : Math.log1p(s) / r);
+                        break;
+                    }
+                    case 4: {
+                        const dx = x - params[p];
+                        const dy = y - params[p + 1];
+                        phi -= 0.5 * params[p + 2] * params[p + 2] * (dx * dx + dy * dy);
+                        break;
+                    }
+                }
+            }
+            energy += body.mass * phi;
+        }
+        return energy;
+    }
+
+    /**
+     * Circular speed at radius r about the field centres, for building equilibrium discs.
+     * Uniform, drag and rotating-frame terms are ignored.
+     */
+    circularVelocitySquared(r, gravitationalConstant) {
+        let v2 = 0;
+        for (let f = 0, p = 0; f < this.count; f++, p += FORCE_FIELD_STRIDE) {
+            if (this.types[f] === 2) {
+                v2 += this.params[p + 2] * r * r / (r * r + this.params[p + 3]);
+            } else if (this.types[f] === 3 && r > 0) {
+                const s = r / this.params[p + 3];
+                v2 += gravitationalConstant * this.params[p + 2] * (Math.log1p(s) - s / (1 + s)) / r;
+            }
+        }
+        return v2;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { FORCE_FIELD_TYPE, ForceFieldSet };
+}
@@ -208,7 +208,9 @@ class GPUPhysicsEngine {
                 !isFinite(body.position.x) || !isFinite(body.position.y) ||
                 !isFinite(body.velocity.x) || !isFinite(body.velocity.y) ||
                 !isFinite(body.mass) || body.mass <= 0) {
-                console.warn(`GPU Physics: Invalid body data detected at index ${i}, falling back to CPU`);
+                if (Diagnostics.counts[DIAGNOSTIC.GPU_INVALID_DATA]++ === 0) {
+                    Diagnostics.sample(DIAGNOSTIC.GPU_INVALID_DATA, `invalid input body at index ${i}, fell back to CPU`);
+                }
                 return false;
             }
         }
@@ -279,7 +281,9 @@ class GPUPhysicsEngine {
                 const result = newState[i];
                 
                 if (!result || !Array.isArray(result) || result.length < 4) {
-                    console.warn(`GPU Physics: Invalid result for body ${i}`);
+                    if (Diagnostics.counts[DIAGNOSTIC.GPU_INVALID_DATA]++ === 0) {
+                        Diagnostics.sample(DIAGNOSTIC.GPU_INVALID_DATA, `malformed result for body ${i}`);
+                    }
                     return false;
                 }
                 
@@ -290,7 +294,9 @@ class GPUPhysicsEngine {
                 const newVelY = result[3];
                 
                 if (!isFinite(newPosX) || !isFinite(newPosY) || !isFinite(newVelX) || !isFinite(newVelY)) {
-                    console.warn(`GPU Physics: Non-finite values detected for body ${i}`);
+                    if (Diagnostics.counts[DIAGNOSTIC.GPU_INVALID_DATA]++ === 0) {
+                        Diagnostics.sample(DIAGNOSTIC.GPU_INVALID_DATA, `non-finite result for body ${i}`);
+                    }
                     return false;
                 }
                 
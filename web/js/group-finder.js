@@ -0,0 +1,397 @@
+/**
+ * Friends-of-friends group finder
+ * Bodies closer than the linking length are friends, and a group is every body that
+ * can be reached through a chain of friends. Pairs come from a uniform hashed grid
+ * and are joined with union-find, so a catalog costs O(N) expected time plus the
+ * sorting in the statistics. Groups can then be cleaned of members that are not
+ * bound to them, with tree potentials once a group is large.
+ *
+ * The search runs as the 'group-catalog' scheduler job (normally in the physics
+ * worker). GroupCatalog keeps group identities from one catalog to the next on the
+ * receiving side and turns the differences into formation, merger and dissolution
+ * events.
+ */
+
+class GroupFinder {
+    /**
+     * Generator behind the 'group-catalog' job. Yields progress in [0, 1].
+     * payload: { x, y, vx, vy, mass, ids (Float64Array), linkingLength (0 = automatic),
+     *            linkingFactor, minMembers, unbind, gravitationalConstant, softeningParameter }
+     */
+    static *find(payload) {
+        const startTime = performance.now();
+        const { x, y, mass } = payload;
+        const n = mass.length;
+        const minMembers = Math.max(2, payload.minMembers | 0);
+        const linkingLength = payload.linkingLength > 0
+            ? payload.linkingLength
+            : GroupFinder.automaticLinkingLength(x, y, n, payload.linkingFactor);
+        yield 0.05;
+        
+        // Equal radii put every body on one grid level with cells one linking length wide
+        const grid = new MultiLevelGrid();
+        grid.build(x, y, new Float64Array(n).fill(linkingLength * 0.5), n);
+        yield 0.1;
+        
+        const links = new ContactIslands();
+        links.reset(n);
+        const linkingSquared = linkingLength * linkingLength;
+        const link = (i, j) => {
+            const dx = x[i] - x[j];
+            const dy = y[i] - y[j];
+            if (dx * dx + dy * dy <= linkingSquared) links.union(i, j);
+        };
+        
+        const bodiesPerSlice = 1000;
+        for (let first = 0; first < n; first += bodiesPerSlice) {
+            const last = Math.min(n, first + bodiesPerSlice);
+            grid.forEachCandidatePair(link, first, last);
+            yield 0.1 + 0.5 * last / n;
+        }
+        
+        // Counting sort of bodies by root, keeping only roots with enough members
+        const root = new Int32Array(n);
+        const start = new Int32Array(n + 1);
+        for (let i = 0; i < n; i++) {
+            root[i] = links.find(i);
+        }
+        for (let i = 0; i < n; i++) {
+            if (links.size[root[i]] >= minMembers) start[root[i] + 1]++;
+        }
+        for (let i = 0; i < n; i++) {
+            start[i + 1] += start[i];
+        }
+        const order = new Int32Array(start[n]);
+        const fill = start.slice(0, n);
+        for (let i = 0; i < n; i++) {
+            if (links.size[root[i]] >= minMembers) order[fill[root[i]]++] = i;
+        }
+        
+        const groups = [];
+        let groupedBodies = 0;
+        for (let r = 0; r < n; r++) {
+            if (start[r + 1] === start[r]) continue;
+            
+            let members = order.subarray(start[r], start[r + 1]);
+            if (payload.unbind) {
+                members = yield* GroupFinder.unbind(members, payload, minMembers);
+            }
+            if (members.length >= minMembers) {
+                groups.push(GroupFinder.describe(members, payload));
+                groupedBodies += members.length;
+            }
+            yield 0.6 + 0.4 * start[r + 1] / order.length;
+        }
+        
+        groups.sort((a, b) => b.mass - a.mass);
+        
+        return {
+            groups,
+            linkingLength,
+            bodyCount: n,
+            groupedBodies,
+            elapsed: performance.now() - startTime
+        };
+    }
+
+    /**
+     * linkingFactor times the mean separation inside the box that holds the central
+     * 90% of bodies along each axis (outliers would otherwise inflate it)
+     */
+    static automaticLinkingLength(x, y, n, linkingFactor = PHYSICS_CONSTANTS.GROUP_LINKING_FACTOR) {
+        if (n < 2) return 1;
+        
+        const sortedX = Float64Array.from(x.subarray(0, n)).sort();
+        const sortedY = Float64Array.from(y.subarray(0, n)).sort();
+        const low = Math.floor(n * 0.05);
+        const high = Math.ceil(n * 0.95) - 1;
+        const area = (sortedX[high] - sortedX[low]) * (sortedY[high] - sortedY[low]);
+        
+        // The box holds about 0.9 × 0.9 of the bodies
+        const separation = Math.sqrt(area / (0.81 * n));
+        return separation > 0 ? linkingFactor * separation : 1;
+    }
+
+    /**
+     * Repeatedly drop members whose energy relative to the group is positive, until
+     * every remaining member is bound or too few are left
+     */
+    static *unbind(members, payload, minMembers) {
+        const { x, y, vx, vy, mass, gravitationalConstant, softeningParameter } = payload;
+        const softeningSquared = softeningParameter * softeningParameter;
+        let current = members;
+        
+        for (let pass = 0; pass < PHYSICS_CONSTANTS.GROUP_UNBIND_PASSES && current.length >= minMembers; pass++) {
+            const m = current.length;
+            
+            let totalMass = 0;
+            let momentumX = 0;
+            let momentumY = 0;
+            for (let k = 0; k < m; k++) {
+                const i = current[k];
+                totalMass += mass[i];
+                momentumX += mass[i] * vx[i];
+                momentumY += mass[i] * vy[i];
+            }
+            const centreVx = momentumX / totalMass;
+            const centreVy = momentumY / totalMass;
+            
+            let potentials;
+            if (m <= PHYSICS_CONSTANTS.GROUP_DIRECT_POTENTIAL_MEMBERS) {
+                potentials = new Float64Array(m);
+                for (let a = 0; a < m; a++) {
+                    const i = current[a];
+                    for (let b = a + 1; b < m; b++) {
+                        const j = current[b];
+                        const dx = x[i] - x[j];
+                        const dy = y[i] - y[j];
+                        const inverseDistance = gravitationalConstant / Math.sqrt(dx * dx + dy * dy + softeningSquared);
+                        potentials[a] -= mass[j] * inverseDistance;
+                        potentials[b] -= mass[i] * inverseDistance;
+                    }
+                }
+            } else {
+                const members = new Array(m);
+                for (let k = 0; k < m; k++) {
+                    const i = current[k];
+                    members[k] = { position: { x: x[i], y: y[i] }, mass: mass[i] };
+                }
+                potentials = new OptimizedBarnesHutForceCalculator()
+                    .calculatePotentials(members, gravitationalConstant, softeningParameter);
+                yield;
+            }
+            
+            const bound = new Int32Array(m);
+            let boundCount = 0;
+            for (let k = 0; k < m; k++) {
+                const i = current[k];
+                const dvx = vx[i] - centreVx;
+                const dvy = vy[i] - centreVy;
+                if (0.5 * (dvx * dvx + dvy * dvy) + potentials[k] < 0) {
+                    bound[boundCount++] = i;
+                }
+            }
+            
+            if (boundCount === m) break;
+            current = bound.subarray(0, boundCount);
+        }
+        
+        return current;
+    }
+
+    /**
+     * Mass, centre of mass, mean velocity and radii of one group
+     */
+    static describe(members, payload) {
+        const { x, y, vx, vy, mass, ids } = payload;
+        const m = members.length;
+        
+        let totalMass = 0;
+        let massX = 0;
+        let massY = 0;
+        let momentumX = 0;
+        let momentumY = 0;
+        for (let k = 0; k < m; k++) {
+            const i = members[k];
+            totalMass += mass[i];
+            massX += mass[i] * x[i];
+            massY += mass[i] * y[i];
+            momentumX += mass[i] * vx[i];
+            momentumY += mass[i] * vy[i];
+        }
+        const centreX = massX / totalMass;
+        const centreY = massY / totalMass;
+        
+        // Distances sorted outward give the extent and the half-mass radius
+        const distances = new Float64Array(m);
+        const byDistance = new Array(m);
+        for (let k = 0; k < m; k++) {
+            const i = members[k];
+            distances[k] = Math.hypot(x[i] - centreX, y[i] - centreY);
+            byDistance[k] = k;
+        }
+        byDistance.sort((a, b) => distances[a] - distances[b]);
+        
+        let halfMassRadius = 0;
+        let enclosedMass = 0;
+        for (let k = 0; k < m; k++) {
+            enclosedMass += mass[members[byDistance[k]]];
+            if (enclosedMass >= totalMass * 0.5) {
+                halfMassRadius = distances[byDistance[k]];
+                break;
+            }
+        }
+        
+        const memberIds = new Float64Array(m);
+        for (let k = 0; k < m; k++) {
+            memberIds[k] = ids[members[k]];
+        }
+        
+        return {
+            members: m,
+            mass: totalMass,
+            x: centreX,
+            y: centreY,
+            vx: momentumX / totalMass,
+            vy: momentumY / totalMass,
+            radius: distances[byDistance[m - 1]],
+            halfMassRadius,
+            memberIds
+        };
+    }
+}
+
+/**
+ * Successive catalogs on the main thread. Each new group takes the id of the earlier
+ * group that contributed most of its members, so groups keep their identity while
+ * they evolve.
+ */
+class GroupCatalog {
+    constructor() {
+        this.groups = []; // Latest catalog, heaviest first, each with a persistent id
+        this.groupOfBody = new Map(); // body id -> group id in the latest catalog
+        this.events = []; // Recent { type: 'formed' | 'merged' | 'dissolved', groupId, progenitors, time }
+        this.nextGroupId = 1;
+        this.linkingLength = 0;
+        this.time = 0;
+        this.bodyCount = 0;
+        this.groupedBodies = 0;
+        this.stats = {
+            catalogs: 0,
+            lastFindTime: 0
+        };
+    }
+
+    /**
+     * Adopt a 'group-catalog' job result computed for simulation time `time`
+     */
+    update(result, time) {
+        const previousOf = this.groupOfBody;
+        const previousSizes = new Map();
+        this.groups.forEach(group => previousSizes.set(group.id, group.members));
+        
+        const groupOfBody = new Map();
+        const taken = new Set();
+        const groups = result.groups;
+        
+        // Heaviest groups choose first
+        for (const group of groups) {
+            const votes = new Map();
+            for (let k = 0; k < group.memberIds.length; k++) {
+                const previousId = previousOf.get(group.memberIds[k]);
+                if (previousId !== undefined) votes.set(previousId, (votes.get(previousId) || 0) + 1);
+            }
+            
+            let bestId = 0;
+            let bestVotes = 0;
+            const progenitors = [];
+            votes.forEach((count, previousId) => {
+                // A progenitor handed at least half of its members to this group
+                if (count * 2 >= previousSizes.get(previousId)) progenitors.push(previousId);
+                if (count > bestVotes && !taken.has(previousId)) {
+                    bestId = previousId;
+                    bestVotes = count;
+                }
+            });
+            
+            group.id = bestId || this.nextGroupId++;
+            group.progenitors = progenitors;
+            taken.add(group.id);
+            for (let k = 0; k < group.memberIds.length; k++) {
+                groupOfBody.set(group.memberIds[k], group.id);
+            }
+            
+            if (!bestId) {
+                this.addEvent({ type: 'formed', groupId: group.id, progenitors, time });
+            } else if (progenitors.length > 1) {
+                this.addEvent({ type: 'merged', groupId: group.id, progenitors, time });
+            }
+        }
+        
+        // Earlier groups that neither continue nor merged into a new one have dissolved
+        const absorbed = new Set();
+        groups.forEach(group => group.progenitors.forEach(id => absorbed.add(id)));
+        previousSizes.forEach((size, id) => {
+            if (!taken.has(id) && !absorbed.has(id)) {
+                this.addEvent({ type: 'dissolved', groupId: id, progenitors: [], time });
+            }
+        });
+        
+        this.groups = groups;
+        this.groupOfBody = groupOfBody;
+        this.linkingLength = result.linkingLength;
+        this.bodyCount = result.bodyCount;
+        this.groupedBodies = result.groupedBodies;
+        this.time = time;
+        this.stats.catalogs++;
+        this.stats.lastFindTime = result.elapsed;
+    }
+
+    addEvent(event) {
+        this.events.push(event);
+        if (this.events.length > PHYSICS_CONSTANTS.GROUP_EVENT_HISTORY) {
+            this.events.shift();
+        }
+    }
+
+    getGroupOfBody(bodyId) {
+        return this.groupOfBody.get(bodyId) || 0;
+    }
+
+    clear() {
+        this.groups = [];
+        this.groupOfBody = new Map();
+        this.events = [];
+        this.linkingLength = 0;
+        this.time = 0;
+        this.bodyCount = 0;
+        this.groupedBodies = 0;
+    }
+
+    // Memory for the ledger: member id arrays, one membership entry per grouped body and the events
+    getMemoryUsage() {
+        let bytes = 0;
+        for (const group of this.groups) bytes += group.memberIds.byteLength;
+        const objects = this.groups.length + this.groupOfBody.size + this.events.length;
+        return { bytes: bytes + objects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES, objects };
+    }
+
+    getStats() {
+        return {
+            ...this.stats,
+            groups: this.groups.length,
+            groupedFraction: this.bodyCount > 0 ? this.groupedBodies / this.bodyCount : 0,
+            largestGroup: this.groups.length > 0 ? this.groups[0].members : 0,
+            linkingLength: this.linkingLength
+        };
+    }
+
+    /**
+     * Plain catalog with memberships, for exports
+     */
+    toJSON() {
+        return {
+            time: this.time,
+            linkingLength: this.linkingLength,
+            groups: this.groups.map(group => ({
+                id: group.id,
+                members: group.members,
+                mass: group.mass,
+                x: group.x,
+                y: group.y,
+                vx: group.vx,
+                vy: group.vy,
+                radius: group.radius,
+                halfMassRadius: group.halfMassRadius,
+                progenitors: group.progenitors,
+                memberIds: Array.from(group.memberIds)
+            })),
+            events: this.events.slice()
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { GroupFinder, GroupCatalog };
+}
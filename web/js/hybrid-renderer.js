@@ -32,6 +32,10 @@ class HybridRenderer {
         this.lastRendererSwitch = 0;
         this.switchCooldown = 2000; // 2 seconds between switches
         
+        // Dynamic resolution: the scene render scale follows the measured frame interval,
+        // so a slow high-DPI frame is answered with fewer pixels before a renderer swap
+        this.resolutionScaler = new ResolutionScaler();
+        
         this.initializeRenderer();
     }
 
@@ -79,11 +83,21 @@ class HybridRenderer {
             this.evaluateRendererSwitch(bodies.length);
         }
         
+        // Renderers without a scalable render target always draw at full resolution
+        const scalable = !!this.currentRenderer.setRenderScale;
+        if (scalable) {
+            this.currentRenderer.setRenderScale(this.resolutionScaler.scale);
+        }
+        
         // Render with current renderer
         this.currentRenderer.render(bodies, physicsEngine, selectedBody);
         
         // Track performance
         this.frameTime = performance.now() - startTime;
+        if (scalable) {
+            // Only the render cost drives the scale; physics time is not shortened by it
+            this.resolutionScaler.update(this.frameTime);
+        }
         this.updatePerformanceHistory();
         
         return this.getStats();
@@ -186,6 +200,12 @@ class HybridRenderer {
         }
     }
 
+    setTrailMode(mode) {
+        if (this.currentRenderer && this.currentRenderer.setTrailMode) {
+            this.currentRenderer.setTrailMode(mode);
+        }
+    }
+
     setShowGrid(show) {
         if (this.currentRenderer && this.currentRenderer.setShowGrid) {
             this.currentRenderer.setShowGrid(show);
@@ -300,9 +320,15 @@ class HybridRenderer {
         }
     }
 
-    setLongTermPreview(show) {
+    setLongTermPreview(show, previewData = null) {
         if (this.currentRenderer && this.currentRenderer.setLongTermPreview) {
-            this.currentRenderer.setLongTermPreview(show);
+            this.currentRenderer.setLongTermPreview(show, previewData);
+        }
+    }
+
+    setGroupCatalog(groups) {
+        if (this.currentRenderer && this.currentRenderer.setGroupCatalog) {
+            this.currentRenderer.setGroupCatalog(groups);
         }
     }
 
@@ -330,6 +356,13 @@ class HybridRenderer {
         }
     }
 
+    // Only the canvas renderer draws the heatmap
+    setCostOverlay(show) {
+        if (this.currentRenderer && this.currentRenderer.setCostOverlay) {
+            this.currentRenderer.setCostOverlay(show);
+        }
+    }
+
     calculateOrbitPreview(body, bodies, physics) {
         if (this.currentRenderer && this.currentRenderer.calculateOrbitPreview) {
             return this.currentRenderer.calculateOrbitPreview(body, bodies, physics);
@@ -371,6 +404,14 @@ class HybridRenderer {
         }
     }
 
+    setResolutionScaling(enabled) {
+        this.resolutionScaler.setEnabled(enabled);
+    }
+
+    setRenderScaleBounds(minScale, maxScale) {
+        this.resolutionScaler.setBounds(minScale, maxScale);
+    }
+
     // Canvas setup method (delegated to current renderer)
     setupCanvas() {
         if (this.currentRenderer && this.currentRenderer.setupCanvas) {
@@ -438,7 +479,8 @@ class HybridRenderer {
             frameCount: this.frameCount,
             webglSupported: this.webglSupported,
             renderingMode: this.renderingMode,
-            performanceMode: this.performanceMode
+            performanceMode: this.performanceMode,
+            resolution: this.resolutionScaler.getStats()
         };
         
         // Add renderer-specific stats
@@ -455,6 +497,21 @@ class HybridRenderer {
         }
     }
 
+    // Memory held by the active renderer, or null when it does not report any
+    getMemoryUsage() {
+        if (this.currentRenderer && this.currentRenderer.getMemoryUsage) {
+            return this.currentRenderer.getMemoryUsage();
+        }
+        return null;
+    }
+
+    shrinkCaches() {
+        if (this.currentRenderer && this.currentRenderer.shrinkCaches) {
+            return this.currentRenderer.shrinkCaches();
+        }
+        return false;
+    }
+
     destroy() {
         if (this.currentRenderer && this.currentRenderer.destroy) {
             this.currentRenderer.destroy();
@@ -469,7 +526,13 @@ class HybridRenderer {
 class OptimizedCanvas2DRenderer {
     constructor(canvas) {
         this.canvas = canvas;
-        this.ctx = canvas.getContext('2d');
+        this.displayContext = canvas.getContext('2d');
+        this.ctx = this.displayContext; // Context being drawn to: the render target while the scene is drawn
+        
+        // Scaled-down render target for the scene, upscaled onto the display canvas
+        this.renderScale = 1;
+        this.renderTarget = null;
+        this.renderTargetContext = null;
         this.width = canvas.width;
         this.height = canvas.height;
         this.devicePixelRatio = window.devicePixelRatio || 1;
@@ -485,6 +548,8 @@ class OptimizedCanvas2DRenderer {
         
         // Visual settings
         this.showTrails = true;
+        this.trailMode = 'polyline'; // 'polyline' strokes every trail; 'accumulation' paints into a fading layer
+        this.trailLayer = new TrailLayer();
         this.showGrid = true;
         this.showForces = false;
         this.showInfo = true;
@@ -492,6 +557,13 @@ class OptimizedCanvas2DRenderer {
         this.showLongTermPreview = false;
         this.showCollisionBounds = false;
         this.orbitPreviewPoints = [];
+        this.orbitPreview = null; // Last short-term preview result (method, conic, perturbation)
+        this.longTermPreviewPoints = [];
+        this.longTermPreviewCollision = false;
+        this.groups = []; // Latest friends-of-friends catalog, drawn as outlines
+        this.showCostOverlay = false; // Colour bodies by their interaction count from the physics cost profile
+        this.costBuckets = new Uint8Array(0); // Heat bucket per body, reused between frames
+        this.costColors = Array.from({ length: 8 }, (_, k) => `hsl(${240 - k * 240 / 7}, 100%, 55%)`); // Cold to hot
         
         // Performance optimizations
         this.enableCulling = true;
@@ -515,6 +587,7 @@ class OptimizedCanvas2DRenderer {
             bodiesRendered: 0,
             bodiesCulled: 0,
             renderTime: 0,
+            passTimes: { trails: 0, bodies: 0, overlay: 0 }, // Milliseconds per render pass, last frame
             fps: 60
         };
         
@@ -522,17 +595,44 @@ class OptimizedCanvas2DRenderer {
     }
 
     setupCanvas() {
-        // Scale for device pixel ratio
-        const dpr = this.devicePixelRatio;
-        this.ctx.scale(dpr, dpr);
-        
+        // width and height are already in device pixels, so the base transform is set per
+        // frame from the render scale rather than scaled here by the device pixel ratio
+        this.setupContext(this.displayContext);
+    }
+
+    setupContext(ctx) {
         // Enable optimizations
-        this.ctx.imageSmoothingEnabled = true;
-        this.ctx.imageSmoothingQuality = 'high';
+        ctx.imageSmoothingEnabled = true;
+        ctx.imageSmoothingQuality = 'high';
         
         // Set text rendering optimizations
-        this.ctx.textAlign = 'center';
-        this.ctx.textBaseline = 'middle';
+        ctx.textAlign = 'center';
+        ctx.textBaseline = 'middle';
+    }
+
+    setRenderScale(scale) {
+        this.renderScale = scale;
+    }
+
+    // Context the scene is drawn to this frame: the display canvas at full scale, otherwise
+    // a render target of the scaled size (resized only when the scale steps)
+    getSceneContext() {
+        if (this.renderScale >= 1) {
+            return this.displayContext;
+        }
+        
+        const width = Math.max(1, Math.round(this.width * this.renderScale));
+        const height = Math.max(1, Math.round(this.height * this.renderScale));
+        if (!this.renderTarget) {
+            this.renderTarget = document.createElement('canvas');
+            this.renderTargetContext = this.renderTarget.getContext('2d', { alpha: false });
+        }
+        if (this.renderTarget.width !== width || this.renderTarget.height !== height) {
+            this.renderTarget.width = width;
+            this.renderTarget.height = height;
+            this.setupContext(this.renderTargetContext);
+        }
+        return this.renderTargetContext;
     }
 
     clear() {
@@ -542,6 +642,10 @@ class OptimizedCanvas2DRenderer {
 
     updateCamera() {
         this.camera.zoom += (this.camera.targetZoom - this.camera.zoom) * this.camera.smoothing;
+        // Snap the tail of the easing, so views that wait for a settled zoom do not wait for ever
+        if (Math.abs(this.camera.targetZoom - this.camera.zoom) <= this.camera.targetZoom * RENDERING_CONSTANTS.ZOOM_SNAP) {
+            this.camera.zoom = this.camera.targetZoom;
+        }
         
         // Update view bounds for culling
         const halfWidth = this.width / (2 * this.camera.zoom);
@@ -556,14 +660,17 @@ class OptimizedCanvas2DRenderer {
     render(bodies, physicsEngine, selectedBody = null) {
         const startTime = performance.now();
         
+        // The scene is drawn in display pixel units whatever the render scale
+        const scale = this.renderScale;
+        this.ctx = this.getSceneContext();
+        this.ctx.setTransform(scale, 0, 0, scale, 0, 0);
+        
         this.clear();
         this.updateCamera();
         
         // Setup transformation matrix
         this.ctx.save();
-        this.ctx.translate(this.width / 2, this.height / 2);
-        this.ctx.scale(this.camera.zoom, this.camera.zoom);
-        this.ctx.translate(-this.camera.x, -this.camera.y);
+        this.applyCameraTransform();
         
         // Reset stats
         this.stats.drawCalls = 0;
@@ -576,20 +683,68 @@ class OptimizedCanvas2DRenderer {
         }
         
         // Render trails first (so they appear behind bodies)
+        const passTimes = this.stats.passTimes;
+        let passStart = performance.now();
         if (this.showTrails) {
-            this.drawTrails(bodies);
+            if (this.trailMode === 'accumulation') {
+                this.drawTrailLayer(bodies);
+            } else {
+                this.drawTrails(bodies);
+            }
         }
+        let passEnd = performance.now();
+        passTimes.trails = passEnd - passStart;
+        passStart = passEnd;
         
         // Render bodies with culling and LOD
         this.drawBodies(bodies, selectedBody);
+        if (this.showCostOverlay && physicsEngine && physicsEngine.costProfile && physicsEngine.costProfile.count > 0) {
+            this.drawCostOverlay(bodies, physicsEngine.costProfile);
+        }
         
         this.ctx.restore();
+        passEnd = performance.now();
+        passTimes.bodies = passEnd - passStart;
+        passStart = passEnd;
+        
+        // Upscale a reduced scene onto the display canvas
+        if (this.ctx !== this.displayContext) {
+            this.displayContext.setTransform(1, 0, 0, 1, 0, 0);
+            this.displayContext.drawImage(this.renderTarget, 0, 0, this.width, this.height);
+        }
+        this.ctx = this.displayContext;
+        
+        // Previews and group outlines are thin lines and text, kept at native resolution
+        const showLongTermPreview = this.showLongTermPreview && this.longTermPreviewPoints.length > 1;
+        const showOrbitPreview = this.showOrbitPreview && this.orbitPreviewPoints.length > 1;
+        if (showLongTermPreview || showOrbitPreview || this.groups.length > 0) {
+            this.ctx.setTransform(1, 0, 0, 1, 0, 0);
+            this.ctx.save();
+            this.applyCameraTransform();
+            if (showLongTermPreview) {
+                this.drawLongTermPreview();
+            }
+            if (showOrbitPreview) {
+                this.drawOrbitPreview();
+            }
+            if (this.groups.length > 0) {
+                this.drawGroups();
+            }
+            this.ctx.restore();
+        }
+        passTimes.overlay = performance.now() - passStart;
         
         // Update performance stats
         this.stats.renderTime = performance.now() - startTime;
         this.stats.fps = 1000 / this.stats.renderTime;
     }
 
+    applyCameraTransform() {
+        this.ctx.translate(this.width / 2, this.height / 2);
+        this.ctx.scale(this.camera.zoom, this.camera.zoom);
+        this.ctx.translate(-this.camera.x, -this.camera.y);
+    }
+
     drawBodies(bodies, selectedBody) {
         for (const body of bodies) {
             // Frustum culling
@@ -608,6 +763,45 @@ class OptimizedCanvas2DRenderer {
         }
     }
 
+    /**
+     * Heatmap of the per-body cost profile: each visible body is filled in one of a few
+     * colours on a log scale up to the costliest body, one path per colour. Bodies are
+     * matched to the profile by index, so those beyond its count (archived escapers) are left out.
+     */
+    drawCostOverlay(bodies, profile) {
+        const n = Math.min(bodies.length, profile.count);
+        if (this.costBuckets.length < n) {
+            this.costBuckets = new Uint8Array(Math.max(n, this.costBuckets.length * 2));
+        }
+        const buckets = this.costBuckets;
+        const colorCount = this.costColors.length;
+        const logMax = Math.log2(profile.getMaxCost() + 1);
+        if (logMax === 0) return;
+        
+        for (let i = 0; i < n; i++) {
+            const level = Math.log2(profile.getCost(i) + 1) / logMax;
+            buckets[i] = Math.min(colorCount - 1, Math.floor(level * colorCount));
+        }
+        
+        const minRadius = 2 / this.camera.zoom;
+        this.ctx.globalAlpha = 0.85;
+        for (let bucket = 0; bucket < colorCount; bucket++) {
+            this.ctx.beginPath();
+            for (let i = 0; i < n; i++) {
+                if (buckets[i] !== bucket) continue;
+                const body = bodies[i];
+                if (this.enableCulling && !this.isBodyVisible(body)) continue;
+                const radius = Math.max(body.radius, minRadius);
+                this.ctx.moveTo(body.position.x + radius, body.position.y);
+                this.ctx.arc(body.position.x, body.position.y, radius, 0, Math.PI * 2);
+            }
+            this.ctx.fillStyle = this.costColors[bucket];
+            this.ctx.fill();
+        }
+        this.ctx.globalAlpha = 1;
+        this.stats.drawCalls += colorCount;
+    }
+
     isBodyVisible(body) {
         const margin = body.radius;
         return (
@@ -673,6 +867,38 @@ class OptimizedCanvas2DRenderer {
         this.ctx.fill();
     }
 
+    /**
+     * Memory for the ledger: caches (gradients, trail colours), layers (canvas pixels,
+     * accumulated trails, heatmap scratch) and previews (orbit preview points)
+     */
+    getMemoryUsage() {
+        const objectBytes = RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES;
+        const cacheObjects = this.gradientCache.size + this.trailLayer.colorCache.size;
+        const canvasBytes = canvas => canvas ? canvas.width * canvas.height * 4 : 0;
+        const trailLayer = this.trailLayer.getMemoryUsage();
+        const previewObjects = 2 * (this.orbitPreviewPoints.length + this.longTermPreviewPoints.length); // Point and its Vector2D
+        
+        return {
+            caches: { bytes: cacheObjects * objectBytes, objects: cacheObjects },
+            layers: {
+                bytes: canvasBytes(this.canvas) + canvasBytes(this.renderTarget) + trailLayer.bytes + this.costBuckets.byteLength,
+                objects: trailLayer.objects
+            },
+            previews: { bytes: previewObjects * objectBytes, objects: previewObjects }
+        };
+    }
+
+    // Budget shedding: allow fewer cached gradients and rebuild the caches from empty
+    shrinkCaches() {
+        const minimum = RENDERING_CONSTANTS.MEMORY_MIN_GRADIENT_CACHE;
+        if (this.maxCacheSize <= minimum && this.gradientCache.size === 0) return false;
+        
+        this.maxCacheSize = Math.max(minimum, Math.floor(this.maxCacheSize * RENDERING_CONSTANTS.MEMORY_SHED_FACTOR));
+        this.gradientCache.clear();
+        this.trailLayer.colorCache.clear();
+        return true;
+    }
+
     getGradient(color, radius) {
         const key = `${color}_${radius}`;
         
@@ -699,25 +925,163 @@ class OptimizedCanvas2DRenderer {
         this.ctx.lineCap = 'round';
         
         for (const body of bodies) {
-            if (!body.trail || body.trail.length < 2) continue;
+            if (!body.trail || body.trail.length === 0) continue;
             
             // Simple culling for trails
             if (this.enableCulling && !this.isBodyVisible(body)) continue;
             
+            // Older decimated history, fainter, running into the start of the trail
+            if (body.trailHistory) {
+                this.drawTrailHistory(body);
+            }
+            
             this.ctx.strokeStyle = this.hexToRgba(body.color, 0.6);
             this.ctx.beginPath();
             
-            const trail = body.trail;
-            this.ctx.moveTo(trail[0].x, trail[0].y);
+            // The trail is a circular buffer; walk it oldest first
+            const first = body.trailPoint(0);
+            this.ctx.moveTo(first.x, first.y);
             
-            for (let i = 1; i < trail.length; i++) {
-                this.ctx.lineTo(trail[i].x, trail[i].y);
+            for (let i = 1; i < body.trail.length; i++) {
+                const point = body.trailPoint(i);
+                this.ctx.lineTo(point.x, point.y);
             }
+            // Points are spaced out, so close the gap from the newest one to the body
+            this.ctx.lineTo(body.position.x, body.position.y);
             
             this.ctx.stroke();
         }
     }
 
+    drawTrailHistory(body) {
+        const ctx = this.ctx;
+        let started = false;
+        ctx.strokeStyle = this.hexToRgba(body.color, 0.3);
+        ctx.beginPath();
+        body.trailHistory.forEachPoint((x, y) => {
+            if (started) {
+                ctx.lineTo(x, y);
+            } else {
+                ctx.moveTo(x, y);
+                started = true;
+            }
+        });
+        if (started) {
+            const first = body.trailPoint(0);
+            ctx.lineTo(first.x, first.y);
+            ctx.stroke();
+        }
+    }
+
+    // Accumulated trails: update the fading layer and lay it over the grid
+    drawTrailLayer(bodies) {
+        const scale = this.renderScale;
+        const layer = this.trailLayer.update(bodies, this.camera, this.width, this.height, scale, 2 / this.camera.zoom);
+        
+        this.ctx.save();
+        this.ctx.setTransform(scale, 0, 0, scale, 0, 0);
+        this.ctx.drawImage(layer, 0, 0, this.width, this.height);
+        this.ctx.restore();
+        this.stats.drawCalls++;
+    }
+
+    // Predicted path computed by the scheduler's 'orbit-prediction' job
+    drawLongTermPreview() {
+        const points = this.longTermPreviewPoints;
+        
+        this.ctx.save();
+        this.ctx.lineWidth = 1.5 / this.camera.zoom;
+        this.ctx.setLineDash([6 / this.camera.zoom, 4 / this.camera.zoom]);
+        this.ctx.strokeStyle = 'rgba(255, 255, 255, 0.45)';
+        this.ctx.beginPath();
+        this.ctx.moveTo(points[0].x, points[0].y);
+        for (let i = 1; i < points.length; i++) {
+            this.ctx.lineTo(points[i].x, points[i].y);
+        }
+        this.ctx.stroke();
+        
+        // Mark where the path ends in a collision
+        if (this.longTermPreviewCollision) {
+            const end = points[points.length - 1];
+            this.ctx.setLineDash([]);
+            this.ctx.strokeStyle = 'rgba(255, 71, 87, 0.9)';
+            this.ctx.beginPath();
+            this.ctx.arc(end.x, end.y, 6 / this.camera.zoom, 0, Math.PI * 2);
+            this.ctx.stroke();
+        }
+        this.ctx.restore();
+        this.stats.drawCalls++;
+    }
+
+    // Short-term preview: green for a closed orbit, dashed yellow for an open one, red
+    // when it ends on a body. Conic paths are labelled with their eccentricity and how
+    // strongly the other bodies perturb them.
+    drawOrbitPreview() {
+        const points = this.orbitPreviewPoints;
+        const preview = this.orbitPreview || {};
+        const zoom = this.camera.zoom;
+        
+        this.ctx.save();
+        this.ctx.lineWidth = 2 / zoom;
+        if (preview.collision) {
+            this.ctx.strokeStyle = 'rgba(255, 107, 107, 0.9)';
+            this.ctx.setLineDash([5 / zoom, 5 / zoom]);
+        } else if (preview.stable) {
+            this.ctx.strokeStyle = 'rgba(81, 207, 102, 0.9)';
+        } else {
+            this.ctx.strokeStyle = 'rgba(255, 212, 59, 0.9)';
+            this.ctx.setLineDash([10 / zoom, 5 / zoom]);
+        }
+        
+        this.ctx.beginPath();
+        this.ctx.moveTo(points[0].position.x, points[0].position.y);
+        for (let i = 1; i < points.length; i++) {
+            this.ctx.lineTo(points[i].position.x, points[i].position.y);
+        }
+        this.ctx.stroke();
+        
+        if (preview.method === 'conic') {
+            const perturbation = preview.perturbation || 0;
+            this.ctx.fillStyle = perturbation > 0.05 ? 'rgba(255, 212, 59, 0.9)' : 'rgba(255, 255, 255, 0.75)';
+            this.ctx.font = `${11 / zoom}px Inter`;
+            this.ctx.fillText(
+                `e ${preview.conic.eccentricity.toFixed(2)} · perturbation ${(perturbation * 100).toFixed(1)}%`,
+                points[0].position.x + 8 / zoom,
+                points[0].position.y - 8 / zoom
+            );
+        }
+        this.ctx.restore();
+        this.stats.drawCalls++;
+    }
+
+    // Outline each catalogued group at its half-mass radius, labelled with its id
+    drawGroups() {
+        const zoom = this.camera.zoom;
+        const bounds = this.viewBounds;
+        
+        this.ctx.save();
+        this.ctx.lineWidth = 1 / zoom;
+        this.ctx.setLineDash([4 / zoom, 4 / zoom]);
+        this.ctx.strokeStyle = 'rgba(255, 209, 102, 0.6)';
+        this.ctx.fillStyle = 'rgba(255, 209, 102, 0.8)';
+        this.ctx.font = `${11 / zoom}px sans-serif`;
+        
+        for (const group of this.groups) {
+            const radius = Math.max(group.halfMassRadius, 4 / zoom);
+            if (group.x + radius < bounds.left || group.x - radius > bounds.right ||
+                group.y + radius < bounds.top || group.y - radius > bounds.bottom) {
+                continue;
+            }
+            
+            this.ctx.beginPath();
+            this.ctx.arc(group.x, group.y, radius, 0, Math.PI * 2);
+            this.ctx.stroke();
+            this.ctx.fillText(`#${group.id} (${group.members})`, group.x + radius * 0.72, group.y - radius * 0.72);
+        }
+        this.ctx.restore();
+        this.stats.drawCalls++;
+    }
+
     drawGrid() {
         const gridSize = 100;
         const zoom = this.camera.zoom;
@@ -818,9 +1182,19 @@ class OptimizedCanvas2DRenderer {
     }
 
     setShowTrails(show) {
+        // The layer missed everything while hidden
+        if (show && !this.showTrails) {
+            this.trailLayer.reset();
+        }
         this.showTrails = show;
     }
 
+    setTrailMode(mode) {
+        if (mode === this.trailMode) return;
+        this.trailMode = mode;
+        this.trailLayer.reset();
+    }
+
     setShowGrid(show) {
         this.showGrid = show;
     }
@@ -894,6 +1268,7 @@ class OptimizedCanvas2DRenderer {
 
     setOrbitPreview(show, previewData = null) {
         this.showOrbitPreview = show;
+        this.orbitPreview = previewData;
         if (previewData) {
             this.orbitPreviewPoints = previewData.points || [];
         } else {
@@ -901,8 +1276,14 @@ class OptimizedCanvas2DRenderer {
         }
     }
 
-    setLongTermPreview(show) {
+    setLongTermPreview(show, previewData = null) {
         this.showLongTermPreview = show;
+        this.longTermPreviewPoints = show && previewData ? previewData.points || [] : [];
+        this.longTermPreviewCollision = !!(previewData && previewData.collision);
+    }
+
+    setGroupCatalog(groups) {
+        this.groups = groups || [];
     }
 
     fitAllBodies(bodies) {
@@ -942,10 +1323,12 @@ class OptimizedCanvas2DRenderer {
         this.showCollisionBounds = show;
     }
 
+    setCostOverlay(show) {
+        this.showCostOverlay = show;
+    }
+
     calculateOrbitPreview(body, bodies, physics) {
-        // Simplified orbit preview - returns empty for Canvas2D renderer
-        // Full implementation is in the main renderer.js
-        return { points: [] };
+        return OrbitPreview.calculate(body, bodies, physics);
     }
 
     calculateLongTermOrbitPreview(body, bodies, physics) {
@@ -964,7 +1347,7 @@ class OptimizedCanvas2DRenderer {
     }
 
     getStats() {
-        return { ...this.stats };
+        return { ...this.stats, renderScale: this.renderScale };
     }
 
     resize(width, height) {
@@ -975,5 +1358,8 @@ class OptimizedCanvas2DRenderer {
 
     destroy() {
         this.gradientCache.clear();
+        this.trailLayer.destroy();
+        this.renderTarget = null;
+        this.renderTargetContext = null;
     }
 }
@@ -85,11 +85,6 @@ class Integrator {
             body.lastPosition = initial.position.clone();
             body.position = initial.position.add(pos_update);
             body.velocity = initial.velocity.add(vel_update);
-            
-            // Update body properties that are normally handled in update methods
-            body.kineticEnergy = 0.5 * body.mass * body.velocity.magnitudeSquared();
-            body.addToTrail();
-            body.updateVisualEffects(dt);
             body.resetForce();
         }
     }
@@ -118,7 +113,9 @@ class Integrator {
         
         // Prevent infinite recursion
         if (maxRecursionDepth <= 0) {
-            console.warn('Integrator: Maximum recursion depth reached, using current timestep');
+            if (Diagnostics.counts[DIAGNOSTIC.INTEGRATOR_STEP_LIMIT]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.INTEGRATOR_STEP_LIMIT, 'adaptive RK4 hit its recursion limit');
+            }
             this.integrateRK4(bodies, currentDt, forceCalculator);
             return currentDt;
         }
@@ -126,7 +123,9 @@ class Integrator {
         // Ensure minimum timestep to prevent infinite recursion
         const minTimestep = 1e-8;
         if (currentDt < minTimestep) {
-            console.warn('Integrator: Timestep too small, using minimum timestep');
+            if (Diagnostics.counts[DIAGNOSTIC.INTEGRATOR_STEP_LIMIT]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.INTEGRATOR_STEP_LIMIT, 'adaptive RK4 clamped to the minimum timestep');
+            }
             this.integrateRK4(bodies, minTimestep, forceCalculator);
             return minTimestep;
         }
@@ -154,7 +153,9 @@ class Integrator {
             if (newDt >= minTimestep) {
                 return this.integrateAdaptiveRK4(bodies, newDt, forceCalculator, tolerance, maxRecursionDepth - 1);
             } else {
-                console.warn('Integrator: Would create timestep below minimum, using half-step result');
+                if (Diagnostics.counts[DIAGNOSTIC.INTEGRATOR_STEP_LIMIT]++ === 0) {
+                    Diagnostics.sample(DIAGNOSTIC.INTEGRATOR_STEP_LIMIT, 'adaptive RK4 kept the half-step result at the minimum timestep');
+                }
             }
         } else if (maxError < tolerance * 0.1) {
             currentDt = Math.min(originalDt * 1.2, originalDt * 2);
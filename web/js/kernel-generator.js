@@ -0,0 +1,352 @@
+/**
+ * Runtime-specialized force kernels
+ * The direct-sum force loop is generated per configuration: branches for settings that
+ * are off (fixed bodies, per-body potential energy) are left out, and external field
+ * terms are emitted inline with their parameters baked in. G and the softening are
+ * arguments, so dragging the gravity or softening slider reuses the same kernel.
+ * Kernels are cached by a key of the structure inlined, least recently used first
+ * out, so a configuration change compiles at most once and switching back is free.
+ *
+ * All kernels share one signature over packed arrays:
+ *     kernel(x, y, vx, vy, m, fixed, fx, fy, pe, n, G, softeningSquared)
+ * fx/fy receive forces and pe per-body potential energy (half of each pair).
+ */
+
+/**
+ * Reference kernel with every setting checked at run time. Used when code generation
+ * is unavailable (e.g. a Content-Security-Policy without 'unsafe-eval') and as the
+ * baseline for the benchmark. Field forces are not included; see ForceFieldSet.
+ */
+function genericDirectKernel(x, y, vx, vy, m, fixed, fx, fy, pe, n, options) {
+    const softeningSquared = options.softeningParameter * options.softeningParameter;
+    const G = options.gravitationalConstant;
+
+    for (let i = 0; i < n; i++) {
+        fx[i] = 0;
+        fy[i] = 0;
+        if (options.trackPotential) pe[i] = 0;
+    }
+
+    for (let i = 0; i < n; i++) {
+        const xi = x[i];
+        const yi = y[i];
+        const mi = m[i];
+        let axi = 0;
+        let ayi = 0;
+        
+        for (let j = i + 1; j < n; j++) {
+            const dx = x[j] - xi;
+            const dy = y[j] - yi;
+            const distanceSquared = dx * dx + dy * dy + softeningSquared;
+            const inverseDistance = 1 / Math.sqrt(distanceSquared);
+            const scale = G * inverseDistance * inverseDistance * inverseDistance;
+            
+            if (!options.hasFixed || !fixed[i]) {
+                axi += dx * scale * m[j];
+                ayi += dy * scale * m[j];
+            }
+            if (!options.hasFixed || !fixed[j]) {
+                fx[j] -= dx * scale * mi * m[j];
+                fy[j] -= dy * scale * mi * m[j];
+            }
+            if (options.trackPotential) {
+                const potential = -0.5 * G * mi * m[j] * inverseDistance;
+                pe[i] += potential;
+                pe[j] += potential;
+            }
+        }
+        
+        fx[i] += axi * mi;
+        fy[i] += ayi * mi;
+    }
+}
+
+class ForceKernelGenerator {
+    constructor() {
+        this.cache = new Map(); // Configuration key -> compiled kernel, least recently used first
+        this.maxCacheSize = PHYSICS_CONSTANTS.KERNEL_CACHE_SIZE;
+        this.available = typeof Function === 'function'; // Cleared if code generation is refused
+        
+        // Last configuration looked up; the key is only rebuilt when one of these changes
+        this.active = { fields: null, hasFixed: false, trackPotential: false, key: null, kernel: null };
+        this.stats = {
+            compiled: 0,
+            cacheHits: 0,
+            compileTime: 0,
+            activeKey: null
+        };
+    }
+
+    /**
+     * Everything the generated code depends on, as a cache key
+     */
+    static keyFor(options) {
+        return [
+            options.hasFixed ? 'F' : 'f',
+            options.trackPotential ? 'P' : 'p',
+            JSON.stringify(options.fields || [])
+        ].join('|');
+    }
+
+    /**
+     * Specialized kernel for these options, or null when code generation is unavailable.
+     * options: { hasFixed, trackPotential, fields (normalized ForceFieldSet specs) }.
+     * ForceFieldSet replaces its spec array on every change, so an unchanged array
+     * means unchanged fields.
+     */
+    getDirectKernel(options) {
+        if (!this.available) return null;
+        
+        const active = this.active;
+        const fields = options.fields || [];
+        if (active.kernel && active.fields === fields && active.hasFixed === options.hasFixed &&
+            active.trackPotential === options.trackPotential) {
+            this.stats.cacheHits++;
+            return active.kernel;
+        }
+        
+        const key = ForceKernelGenerator.keyFor(options);
+        let kernel = this.cache.get(key);
+        if (kernel) {
+            this.stats.cacheHits++;
+            // Move to the most recently used end
+            this.cache.delete(key);
+            this.cache.set(key, kernel);
+        } else {
+            const startTime = performance.now();
+            const source = ForceKernelGenerator.generateDirectSource(options);
+            try {
+                kernel = new Function('x', 'y', 'vx', 'vy', 'm', 'fixed', 'fx', 'fy', 'pe', 'n', 'G', 'softeningSquared', source);
+            } catch (error) {
+                console.warn('Force kernel generation unavailable, using the generic loop:', error.message);
+                this.available = false;
+                return null;
+            }
+            this.cache.set(key, kernel);
+            if (this.cache.size > this.maxCacheSize) {
+                this.cache.delete(this.cache.keys().next().value);
+            }
+            this.stats.compiled++;
+            this.stats.compileTime += performance.now() - startTime;
+        }
+        
+        active.fields = fields;
+        active.hasFixed = options.hasFixed;
+        active.trackPotential = options.trackPotential;
+        active.key = key;
+        active.kernel = kernel;
+        this.stats.activeKey = key;
+        return kernel;
+    }
+
+    /**
+     * Body of the direct-sum kernel for one configuration
+     */
+    static generateDirectSource(options) {
+        const literal = value => {
+            const number = Number(value);
+            if (!isFinite(number)) throw new Error(`Cannot inline ${value}`);
+            return `(${number})`;
+        };
+        const skipFixed = options.hasFixed;
+        const trackPotential = options.trackPotential;
+        const fields = options.fields || [];
+        
+        const lines = [];
+        lines.push('for (let i = 0; i < n; i++) {');
+        lines.push('    fx[i] = 0;');
+        lines.push('    fy[i] = 0;');
+        if (trackPotential) lines.push('    pe[i] = 0;');
+        lines.push('}');
+        
+        lines.push('for (let i = 0; i < n; i++) {');
+        lines.push('    const xi = x[i];');
+        lines.push('    const yi = y[i];');
+        lines.push('    const mi = m[i];');
+        lines.push('    let axi = 0;');
+        lines.push('    let ayi = 0;');
+        lines.push('    for (let j = i + 1; j < n; j++) {');
+        lines.push('        const dx = x[j] - xi;');
+        lines.push('        const dy = y[j] - yi;');
+        lines.push('        const inverseDistance = 1 / Math.sqrt(dx * dx + dy * dy + softeningSquared);');
+        lines.push('        const scale = G * inverseDistance * inverseDistance * inverseDistance;');
+        lines.push('        const mj = m[j];');
+        lines.push('        axi += dx * scale * mj;');
+        lines.push('        ayi += dy * scale * mj;');
+        lines.push('        fx[j] -= dx * scale * mi * mj;');
+        lines.push('        fy[j] -= dy * scale * mi * mj;');
+        if (trackPotential) {
+            lines.push('        const potential = -0.5 * G * mi * mj * inverseDistance;');
+            lines.push('        pe[i] += potential;');
+            lines.push('        pe[j] += potential;');
+        }
+        lines.push('    }');
+        lines.push('    fx[i] += axi * mi;');
+        lines.push('    fy[i] += ayi * mi;');
+        lines.push('}');
+        
+        // External fields, one straight-line block per declared field
+        if (fields.length > 0) {
+            lines.push('for (let i = 0; i < n; i++) {');
+            if (skipFixed) lines.push('    if (fixed[i]) continue;');
+            lines.push('    let ax = 0;');
+            lines.push('    let ay = 0;');
+            fields.forEach(field => {
+                lines.push(`    {`);
+                lines.push(...ForceKernelGenerator.generateFieldSource(field, literal).map(line => '        ' + line));
+                lines.push(`    }`);
+            });
+            lines.push('    fx[i] += ax * m[i];');
+            lines.push('    fy[i] += ay * m[i];');
+            lines.push('}');
+        }
+        
+        // Fixed bodies keep pulling on others but feel nothing themselves
+        if (skipFixed) {
+            lines.push('for (let i = 0; i < n; i++) {');
+            lines.push('    if (fixed[i]) { fx[i] = 0; fy[i] = 0; }');
+            lines.push('}');
+        }
+        
+        return lines.join('\n');
+    }
+
+    /**
+     * Inline acceleration terms for one field spec (see ForceFieldSet for the formulas)
+     */
+    static generateFieldSource(field, literal) {
+        switch (field.type) {
+            case FORCE_FIELD_TYPE.UNIFORM:
+                return [`ax += ${literal(field.gx)};`, `ay += ${literal(field.gy)};`];
+            case FORCE_FIELD_TYPE.DRAG:
+                return [`ax -= ${literal(field.coefficient)} * vx[i];`, `ay -= ${literal(field.coefficient)} * vy[i];`];
+            case FORCE_FIELD_TYPE.LOGARITHMIC_HALO:
+                return [
+                    `const dx = x[i] - ${literal(field.x)};`,
+                    `const dy = y[i] - ${literal(field.y)};`,
+                    `const scale = ${literal(field.velocity * field.velocity)} / (dx * dx + dy * dy + ${literal(field.coreRadius * field.coreRadius)});`,
+                    'ax -= dx * scale;',
+                    'ay -= dy * scale;'
+                ];
+            case FORCE_FIELD_TYPE.NFW_HALO:
+                return [
+                    `const dx = x[i] - ${literal(field.x)};`,
+                    `const dy = y[i] - ${literal(field.y)};`,
+                    'const r = Math.sqrt(dx * dx + dy * dy);',
+                    'if (r >= 1e-9) {',
+                    `    const s = r / ${literal(field.scaleRadius)};`,
+                    `    const enclosed = s < 1e-4 ? ${literal(field.mass)} * s * s * 0.5 : ${literal(field.mass)} * (Math.log1p(s) - s / (1 + s));`,
+                    '    const scale = G * enclosed / (r * r * r);',
+                    '    ax -= dx * scale;',
+                    '    ay -= dy * scale;',
+                    '}'
+                ];
+            case FORCE_FIELD_TYPE.ROTATING_FRAME:
+                return [
+                    `ax += ${literal(2 * field.omega)} * vy[i] + ${literal(field.omega * field.omega)} * (x[i] - ${literal(field.x)});`,
+                    `ay += ${literal(-2 * field.omega)} * vx[i] + ${literal(field.omega * field.omega)} * (y[i] - ${literal(field.y)});`
+                ];
+            default:
+                throw new Error(`No kernel template for force field ${field.type}`);
+        }
+    }
+
+    clearCache() {
+        this.cache.clear();
+        this.active.kernel = null;
+        this.active.fields = null;
+        this.stats.activeKey = null;
+    }
+
+    // Memory for the ledger: the generated source (UTF-16) kept with each compiled kernel
+    getMemoryUsage() {
+        let characters = 0;
+        this.cache.forEach(kernel => { characters += kernel.toString().length; });
+        const objects = this.cache.size;
+        return { bytes: characters * 2 + objects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES, objects };
+    }
+
+    getStats() {
+        return { ...this.stats, cachedKernels: this.cache.size, available: this.available };
+    }
+
+    /**
+     * Compare the generic and the specialized direct-sum loops on random bodies.
+     * Returns mean milliseconds per force pass for each and the speedup.
+     */
+    static benchmark(bodyCount = 1000, iterations = 20, options = {}) {
+        const fieldSet = new ForceFieldSet();
+        fieldSet.setFields(options.fields || []);
+        const settings = {
+            gravitationalConstant: PHYSICS_CONSTANTS.GRAVITATIONAL_CONSTANT,
+            softeningParameter: PHYSICS_CONSTANTS.SOFTENING_PARAMETER,
+            hasFixed: false,
+            trackPotential: true,
+            ...options,
+            fields: fieldSet.specs
+        };
+        const n = bodyCount;
+        const x = new Float64Array(n);
+        const y = new Float64Array(n);
+        const vx = new Float64Array(n);
+        const vy = new Float64Array(n);
+        const m = new Float64Array(n);
+        const fixed = new Uint8Array(n);
+        const fx = new Float64Array(n);
+        const fy = new Float64Array(n);
+        const pe = new Float64Array(n);
+        for (let i = 0; i < n; i++) {
+            x[i] = Math.random() * 1000;
+            y[i] = Math.random() * 1000;
+            m[i] = 1 + Math.random() * 10;
+        }
+        
+        const generator = new ForceKernelGenerator();
+        const specialized = generator.getDirectKernel(settings);
+        
+        // The generic path applies fields the way the engine did before specialization
+        const runGeneric = () => {
+            genericDirectKernel(x, y, vx, vy, m, fixed, fx, fy, pe, n, settings);
+            if (fieldSet.hasFields()) {
+                const probe = { position: { x: 0, y: 0 }, velocity: { x: 0, y: 0 }, force: { x: 0, y: 0 }, mass: 1 };
+                for (let i = 0; i < n; i++) {
+                    probe.position.x = x[i];
+                    probe.position.y = y[i];
+                    probe.velocity.x = vx[i];
+                    probe.velocity.y = vy[i];
+                    probe.mass = m[i];
+                    probe.force.x = fx[i];
+                    probe.force.y = fy[i];
+                    fieldSet.accumulate(probe, settings.gravitationalConstant);
+                    fx[i] = probe.force.x;
+                    fy[i] = probe.force.y;
+                }
+            }
+        };
+        const softeningSquared = settings.softeningParameter * settings.softeningParameter;
+        const runSpecialized = () => specialized(x, y, vx, vy, m, fixed, fx, fy, pe, n,
+            settings.gravitationalConstant, softeningSquared);
+        
+        const time = run => {
+            run(); // Warm up
+            const startTime = performance.now();
+            for (let k = 0; k < iterations; k++) run();
+            return (performance.now() - startTime) / iterations;
+        };
+        
+        const generic = time(runGeneric);
+        const specializedTime = specialized ? time(runSpecialized) : NaN;
+        return {
+            bodyCount: n,
+            iterations,
+            genericMs: generic,
+            specializedMs: specializedTime,
+            speedup: specialized ? generic / specializedTime : 1
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { genericDirectKernel, ForceKernelGenerator };
+}
@@ -0,0 +1,160 @@
+/**
+ * Memory ledger
+ * Subsystems register a measure callback reporting the typed-array bytes they hold
+ * plus an estimate for their plain objects, an optional byte budget and an optional
+ * shed callback. Every check interval all subsystems are measured; one that is over
+ * its budget is asked to shed load (shorten trails, drop history tiers, shrink
+ * caches) once per check, so a long session settles under its budgets gradually
+ * instead of stalling on one large cleanup. A short history of measurements per
+ * subsystem gives its growth rate, which points at whatever keeps growing.
+ */
+
+class MemoryLedger {
+    constructor() {
+        this.entries = []; // Registration order, which is also the report order
+        this.entriesByName = new Map();
+        this.enforcing = true; // Shed load when a budget is exceeded
+        this.checkInterval = RENDERING_CONSTANTS.MEMORY_CHECK_INTERVAL;
+        this.historySize = RENDERING_CONSTANTS.MEMORY_GROWTH_SAMPLES;
+        this.lastCheckTime = -Infinity;
+        this.sampleCount = 0; // Measurements taken so far; sample k sits at slot k % historySize
+        this.sampleTimes = new Float64Array(this.historySize);
+    }
+
+    /**
+     * measure() returns { bytes, objects }. shed(excessBytes) frees what it can and
+     * returns false once nothing more can be given up.
+     */
+    register(name, { label = name, measure, budget = Infinity, shed = null }) {
+        const entry = {
+            name,
+            label,
+            measure,
+            budget,
+            shed,
+            bytes: 0,
+            objects: 0,
+            peak: 0,
+            history: new Float64Array(this.historySize), // Bytes at each kept measurement
+            sheds: 0, // Times load was shed
+            exhausted: false // Over budget with nothing left to shed
+        };
+        this.entries.push(entry);
+        this.entriesByName.set(name, entry);
+        return entry;
+    }
+
+    setBudget(name, bytes) {
+        const entry = this.entriesByName.get(name);
+        if (!entry) return;
+        entry.budget = bytes > 0 ? bytes : Infinity;
+        entry.exhausted = false;
+    }
+
+    setEnforcing(enforcing) {
+        this.enforcing = enforcing;
+        this.entries.forEach(entry => { entry.exhausted = false; });
+    }
+
+    /**
+     * Measure every subsystem (at most once per check interval) and shed load where a
+     * budget is exceeded. Returns whether a measurement was taken.
+     */
+    update(now, force = false) {
+        if (!force && now - this.lastCheckTime < this.checkInterval) return false;
+        this.lastCheckTime = now;
+        
+        const slot = this.sampleCount % this.historySize;
+        this.sampleTimes[slot] = now;
+        for (const entry of this.entries) {
+            this.measureEntry(entry);
+            
+            if (this.enforcing && entry.shed && entry.bytes > entry.budget && !entry.exhausted) {
+                entry.exhausted = !entry.shed(entry.bytes - entry.budget);
+                entry.sheds++;
+                this.measureEntry(entry);
+            } else if (entry.bytes <= entry.budget) {
+                entry.exhausted = false;
+            }
+            entry.history[slot] = entry.bytes;
+        }
+        this.sampleCount++;
+        return true;
+    }
+
+    measureEntry(entry) {
+        const usage = entry.measure();
+        entry.bytes = usage.bytes;
+        entry.objects = usage.objects;
+        entry.peak = Math.max(entry.peak, usage.bytes);
+    }
+
+    // Bytes per minute over the kept measurements (zero until there are two)
+    getGrowthRate(entry) {
+        const count = Math.min(this.sampleCount, this.historySize);
+        if (count < 2) return 0;
+        
+        const newest = (this.sampleCount - 1) % this.historySize;
+        const oldest = (this.sampleCount - count) % this.historySize;
+        const elapsed = this.sampleTimes[newest] - this.sampleTimes[oldest];
+        return elapsed > 0 ? (entry.history[newest] - entry.history[oldest]) / elapsed * 60000 : 0;
+    }
+
+    getStats() {
+        let bytes = 0;
+        const entries = this.entries.map(entry => {
+            bytes += entry.bytes;
+            return {
+                name: entry.name,
+                label: entry.label,
+                bytes: entry.bytes,
+                objects: entry.objects,
+                budget: entry.budget,
+                peak: entry.peak,
+                growth: this.getGrowthRate(entry),
+                sheds: entry.sheds,
+                exhausted: entry.exhausted
+            };
+        });
+        
+        // Chrome reports the whole heap, which shows how much the ledger does not see
+        const heap = typeof performance !== 'undefined' && performance.memory ? performance.memory.usedJSHeapSize : null;
+        return { enforcing: this.enforcing, bytes, heap, entries };
+    }
+
+    /**
+     * Total byteLength of the typed arrays held directly by each object, counting a
+     * shared buffer once
+     */
+    static typedArrayBytes(holders) {
+        const seen = new Set();
+        let bytes = 0;
+        for (const holder of holders) {
+            if (!holder) continue;
+            for (const value of Object.values(holder)) {
+                if (ArrayBuffer.isView(value) && !seen.has(value.buffer)) {
+                    seen.add(value.buffer);
+                    bytes += value.buffer.byteLength;
+                }
+            }
+        }
+        return bytes;
+    }
+
+    static formatBytes(bytes) {
+        if (!isFinite(bytes)) return '—';
+        const units = ['B', 'KB', 'MB', 'GB'];
+        let unit = 0;
+        let value = Math.abs(bytes);
+        while (value >= 1024 && unit < units.length - 1) {
+            value /= 1024;
+            unit++;
+        }
+        return `${bytes < 0 ? '-' : ''}${value.toFixed(unit === 0 ? 0 : 1)} ${units[unit]}`;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { MemoryLedger };
+}
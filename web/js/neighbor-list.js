@@ -0,0 +1,199 @@
+/**
+ * Verlet neighbor list with a skin radius
+ * Collects every pair of bodies within interaction range plus a skin and reuses
+ * the list across steps. A pair can only come into range after one of its bodies
+ * has moved more than half the skin, so the list is rebuilt exactly then.
+ */
+
+class NeighborList {
+    constructor(skin = PHYSICS_CONSTANTS.NEIGHBOR_LIST_SKIN) {
+        this.skin = skin;
+        this.nearFieldRadius = 0; // Uniform gravity range the list was built for
+        this.sweepTime = 0; // Contact ranges are widened by the distance covered in this time
+        
+        // Half list of candidate pairs (i < j), indices into the bodies array
+        this.pairCapacity = 256;
+        this.pairA = new Int32Array(this.pairCapacity);
+        this.pairB = new Int32Array(this.pairCapacity);
+        this.pairCount = 0;
+        
+        // State captured at build time for the rebuild test
+        this.bodyRefs = [];
+        this.referenceX = new Float64Array(0);
+        this.referenceY = new Float64Array(0);
+        this.referenceRadius = new Float64Array(0); // Swept radius at build time
+        
+        // Multi-level broadphase used for rebuilds
+        this.grid = new MultiLevelGrid();
+        this.gridRadius = new Float64Array(0);
+        
+        this.stats = {
+            builds: 0,
+            reuses: 0,
+            pairs: 0,
+            buildTime: 0
+        };
+    }
+
+    /**
+     * Make sure the list covers the current positions, rebuilding only when required
+     */
+    update(bodies, nearFieldRadius = 0, sweepTime = 0) {
+        if (this.needsRebuild(bodies, nearFieldRadius, sweepTime)) {
+            this.build(bodies, nearFieldRadius, sweepTime);
+            return true;
+        }
+        
+        this.stats.reuses++;
+        return false;
+    }
+
+    /**
+     * A rebuild is needed when the body set or ranges changed, or some body's
+     * displacement plus swept-radius growth has used up half of the skin. A list swept
+     * over a longer time covers a shorter one, so an adaptive step that shrinks a little
+     * keeps it.
+     */
+    needsRebuild(bodies, nearFieldRadius, sweepTime) {
+        if (nearFieldRadius !== this.nearFieldRadius || sweepTime > this.sweepTime ||
+            sweepTime < this.sweepTime * 0.5 || bodies.length !== this.bodyRefs.length) {
+            return true;
+        }
+        
+        const halfSkin = this.skin * 0.5;
+        
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body !== this.bodyRefs[i]) return true;
+            
+            const allowed = halfSkin - Math.max(0, this.sweptRadius(body) - this.referenceRadius[i]);
+            if (allowed <= 0) return true;
+            
+            const dx = body.position.x - this.referenceX[i];
+            const dy = body.position.y - this.referenceY[i];
+            if (dx * dx + dy * dy > allowed * allowed) return true;
+        }
+        
+        return false;
+    }
+
+    /**
+     * Body radius widened by the distance it can cover within the sweep time, so
+     * continuous collision checks still find fast bodies
+     */
+    sweptRadius(body) {
+        if (this.sweepTime <= 0) return body.radius;
+        return body.radius + Math.sqrt(body.velocity.x * body.velocity.x + body.velocity.y * body.velocity.y) * this.sweepTime;
+    }
+
+    /**
+     * Interaction range of a pair: contact distance for collisions, or the near-field
+     * gravity radius, whichever is larger
+     */
+    pairRange(radiusA, radiusB) {
+        return Math.max(radiusA + radiusB, this.nearFieldRadius);
+    }
+
+    /**
+     * Rebuild the pair list from the multi-level grid broadphase
+     */
+    build(bodies, nearFieldRadius = 0, sweepTime = 0) {
+        const startTime = performance.now();
+        const n = bodies.length;
+        
+        this.nearFieldRadius = nearFieldRadius;
+        this.sweepTime = sweepTime;
+        this.pairCount = 0;
+        this.ensureBodyCapacity(n);
+        this.bodyRefs = bodies.slice();
+        
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            this.referenceX[i] = body.position.x;
+            this.referenceY[i] = body.position.y;
+            this.referenceRadius[i] = this.sweptRadius(body);
+        }
+        
+        if (n < 2) {
+            this.finishBuild(startTime);
+            return;
+        }
+        
+        // Half-extent in the broadphase: any pair in range overlaps there
+        const halfSkin = this.skin * 0.5;
+        const halfNearField = nearFieldRadius * 0.5;
+        for (let i = 0; i < n; i++) {
+            this.gridRadius[i] = Math.max(this.referenceRadius[i], halfNearField) + halfSkin;
+        }
+        
+        this.grid.build(this.referenceX, this.referenceY, this.gridRadius, n);
+        this.grid.forEachCandidatePair((i, j) => {
+            const dx = this.referenceX[j] - this.referenceX[i];
+            const dy = this.referenceY[j] - this.referenceY[i];
+            const range = this.pairRange(this.referenceRadius[i], this.referenceRadius[j]) + this.skin;
+            
+            if (dx * dx + dy * dy < range * range) {
+                if (i < j) {
+                    this.addPair(i, j);
+                } else {
+                    this.addPair(j, i);
+                }
+            }
+        });
+        
+        this.finishBuild(startTime);
+    }
+
+    finishBuild(startTime) {
+        this.stats.builds++;
+        this.stats.pairs = this.pairCount;
+        this.stats.buildTime = performance.now() - startTime;
+    }
+
+    addPair(i, j) {
+        if (this.pairCount >= this.pairCapacity) {
+            this.pairCapacity *= 2;
+            const pairA = new Int32Array(this.pairCapacity);
+            const pairB = new Int32Array(this.pairCapacity);
+            pairA.set(this.pairA);
+            pairB.set(this.pairB);
+            this.pairA = pairA;
+            this.pairB = pairB;
+        }
+        
+        this.pairA[this.pairCount] = i;
+        this.pairB[this.pairCount] = j;
+        this.pairCount++;
+    }
+
+    ensureBodyCapacity(n) {
+        if (this.referenceX.length < n) {
+            const capacity = Math.max(n, this.referenceX.length * 2, 16);
+            this.referenceX = new Float64Array(capacity);
+            this.referenceY = new Float64Array(capacity);
+            this.referenceRadius = new Float64Array(capacity);
+            this.gridRadius = new Float64Array(capacity);
+        }
+    }
+
+    /**
+     * Drop the cached list so the next update rebuilds it
+     */
+    invalidate() {
+        this.bodyRefs = [];
+    }
+
+    getStats() {
+        return {
+            ...this.stats,
+            skin: this.skin,
+            nearFieldRadius: this.nearFieldRadius,
+            gridLevels: this.grid.stats.levels
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { NeighborList };
+}
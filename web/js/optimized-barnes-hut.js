@@ -4,11 +4,12 @@
  */
 
 class OptimizedQuadTree {
-    constructor(bounds, maxBodies = 1, depth = 0, maxDepth = 20) {
+    constructor(bounds, maxBodies = 1, depth = 0, maxDepth = 20, minCellSize = 0) {
         this.bounds = bounds; // {x, y, width, height}
-        this.maxBodies = maxBodies;
+        this.maxBodies = maxBodies; // Leaf bucket size before subdividing
         this.depth = depth;
         this.maxDepth = maxDepth;
+        this.minCellSize = minCellSize; // Cells are never split below this size
         
         // Structure of Arrays (SoA) for better memory layout and cache performance
         this.bodyCount = 0;
@@ -22,6 +23,7 @@ class OptimizedQuadTree {
         // Center of mass and total mass
         this.centerOfMass = { x: 0, y: 0 };
         this.totalMass = 0;
+        this.maxMass = 0; // Heaviest single body in the cell, filled in by computeMaxMasses()
         
         // Children nodes
         this.children = null;
@@ -75,45 +77,16 @@ class OptimizedQuadTree {
             return false;
         }
 
-        // If we have room and no children, add the body
-        if (this.bodyCount < this.maxBodies && !this.divided) {
-            // Resize if needed
-            if (this.bodyCount >= this.maxCapacity) {
-                this.resize(this.maxCapacity * 2);
-            }
-            
-            // Add body using SoA layout
-            const idx = this.bodyCount;
-            this.positions[idx * 2] = body.position.x;
-            this.positions[idx * 2 + 1] = body.position.y;
-            this.masses[idx] = body.mass;
-            this.bodyIds[idx] = bodyId;
-            this.bodyCount++;
-            
-            this.updateCenterOfMass();
-            return true;
-        }
-
-        // Check depth limit
-        if (this.depth >= this.maxDepth) {
-            // Force add to this node
-            if (this.bodyCount >= this.maxCapacity) {
-                this.resize(this.maxCapacity * 2);
+        // Leaves are buckets: they take the body while they have room, once they are
+        // as small as allowed, or when everything in them sits on the same point.
+        // Splitting any further could not separate those bodies.
+        if (!this.divided) {
+            if (this.bodyCount < this.maxBodies || this.depth >= this.maxDepth ||
+                Math.max(this.bounds.width, this.bounds.height) * 0.5 < this.minCellSize || this.isCoincidentWith(body.position)) {
+                this.addToBucket(body, bodyId);
+                return true;
             }
             
-            const idx = this.bodyCount;
-            this.positions[idx * 2] = body.position.x;
-            this.positions[idx * 2 + 1] = body.position.y;
-            this.masses[idx] = body.mass;
-            this.bodyIds[idx] = bodyId;
-            this.bodyCount++;
-            
-            this.updateCenterOfMass();
-            return true;
-        }
-
-        // Subdivide if not already divided
-        if (!this.divided) {
             this.subdivide();
         }
 
@@ -132,17 +105,56 @@ class OptimizedQuadTree {
         return inserted;
     }
 
+    /**
+     * Append a body to this leaf and fold it into the running center of mass
+     */
+    addToBucket(body, bodyId) {
+        if (this.bodyCount >= this.maxCapacity) {
+            this.resize(this.maxCapacity * 2);
+        }
+        
+        // Add body using SoA layout
+        const idx = this.bodyCount;
+        this.positions[idx * 2] = body.position.x;
+        this.positions[idx * 2 + 1] = body.position.y;
+        this.masses[idx] = body.mass;
+        this.bodyIds[idx] = bodyId;
+        this.bodyCount++;
+        
+        const totalMass = this.totalMass + this.masses[idx];
+        if (totalMass > 0) {
+            this.centerOfMass.x = (this.centerOfMass.x * this.totalMass + this.positions[idx * 2] * this.masses[idx]) / totalMass;
+            this.centerOfMass.y = (this.centerOfMass.y * this.totalMass + this.positions[idx * 2 + 1] * this.masses[idx]) / totalMass;
+        }
+        this.totalMass = totalMass;
+    }
+
+    /**
+     * True when every body in this leaf sits exactly at the given position
+     */
+    isCoincidentWith(position) {
+        if (this.bodyCount === 0) return false;
+        
+        const x = Math.fround(position.x);
+        const y = Math.fround(position.y);
+        for (let i = 0; i < this.bodyCount; i++) {
+            if (this.positions[i * 2] !== x || this.positions[i * 2 + 1] !== y) return false;
+        }
+        return true;
+    }
+
     /**
      * Optimized subdivision using pre-computed bounds
      */
     subdivide() {
         if (this.divided) return;
 
+        const depth = this.depth + 1;
         this.children = {
-            nw: new OptimizedQuadTree(this.childBounds.nw, this.maxBodies, this.depth + 1, this.maxDepth),
-            ne: new OptimizedQuadTree(this.childBounds.ne, this.maxBodies, this.depth + 1, this.maxDepth),
-            sw: new OptimizedQuadTree(this.childBounds.sw, this.maxBodies, this.depth + 1, this.maxDepth),
-            se: new OptimizedQuadTree(this.childBounds.se, this.maxBodies, this.depth + 1, this.maxDepth)
+            nw: new OptimizedQuadTree(this.childBounds.nw, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            ne: new OptimizedQuadTree(this.childBounds.ne, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            sw: new OptimizedQuadTree(this.childBounds.sw, this.maxBodies, depth, this.maxDepth, this.minCellSize),
+            se: new OptimizedQuadTree(this.childBounds.se, this.maxBodies, depth, this.maxDepth, this.minCellSize)
         };
 
         this.divided = true;
@@ -214,10 +226,18 @@ class OptimizedQuadTree {
     /**
      * Enhanced force calculation with optimized traversal
      * Based on the C++ implementation's shared memory approach
+     * When nearFieldRadius is set, bodies closer than that radius are left out and
+     * cells reaching into it are always opened, so the caller can sum them directly.
+     * bodyIndex is the id the body was inserted with, used to skip self-interaction.
      */
-    calculateForce(body, gravitationalConstant, softeningParameter, theta = 0.5) {
+    calculateForce(body, gravitationalConstant, softeningParameter, theta = 0.5, nearFieldRadius = 0, bodyIndex = -1, counts = null) {
         // Use a pre-allocated force accumulator
         const force = { x: 0, y: 0 };
+        let cells = 0;
+        let direct = 0;
+        const nearFieldRadiusSquared = nearFieldRadius * nearFieldRadius;
+        // Without an index, a body at the same position is taken to be the body itself
+        const skipDistanceSquared = bodyIndex >= 0 ? nearFieldRadiusSquared : Math.max(1e-10, nearFieldRadiusSquared);
         
         // Stack-based traversal to avoid recursion overhead
         const nodeStack = [this];
@@ -235,11 +255,25 @@ class OptimizedQuadTree {
             const nodeSize = Math.max(node.bounds.width, node.bounds.height);
             const nodeSizeSquared = nodeSize * nodeSize;
             
-            // Apply Barnes-Hut criteria or if it's a leaf node
-            if (!node.divided || nodeSizeSquared < theta * theta * distanceSquared) {
-                // For leaf nodes with bodies, calculate directly to avoid self-interaction
-                if (!node.divided && node.bodyCount > 0) {
+            // A cell is approximated by its center of mass only when it passes the opening
+            // criterion, does not contain the body itself and stays clear of the near field.
+            // Single-body leaves are always summed directly.
+            let approximate = (node.divided || node.bodyCount > 1) &&
+                nodeSizeSquared < theta * theta * distanceSquared && !node.contains(body.position);
+            
+            if (approximate && nearFieldRadiusSquared > 0) {
+                const gapX = Math.max(node.bounds.x - body.position.x, 0, body.position.x - node.bounds.x - node.bounds.width);
+                const gapY = Math.max(node.bounds.y - body.position.y, 0, body.position.y - node.bounds.y - node.bounds.height);
+                approximate = gapX * gapX + gapY * gapY >= nearFieldRadiusSquared;
+            }
+            
+            if (approximate || !node.divided) {
+                // Leaves that must be opened are summed body by body
+                if (!approximate) {
+                    direct += node.bodyCount;
                     for (let i = 0; i < node.bodyCount; i++) {
+                        if (node.bodyIds[i] === bodyIndex) continue;
+                        
                         const bx = node.positions[i * 2];
                         const by = node.positions[i * 2 + 1];
                         const bMass = node.masses[i];
@@ -248,8 +282,7 @@ class OptimizedQuadTree {
                         const bdy = by - body.position.y;
                         const bDistanceSquared = bdx * bdx + bdy * bdy;
                         
-                        // Skip self-interaction (same position means it's the same body)
-                        if (bDistanceSquared < 1e-10) continue;
+                        if (bDistanceSquared < skipDistanceSquared) continue;
                         
                         const effectiveDistanceSquared = bDistanceSquared + softeningParameter * softeningParameter;
                         const invDistance = 1.0 / Math.sqrt(effectiveDistanceSquared);
@@ -260,7 +293,8 @@ class OptimizedQuadTree {
                         force.y += bdy * forceStrength;
                     }
                 } else if (distanceSquared > 0) {
-                    // Internal node treated as single body
+                    // Distant cell treated as single body
+                    cells++;
                     const effectiveDistanceSquared = distanceSquared + softeningParameter * softeningParameter;
                     const invDistance = 1.0 / Math.sqrt(effectiveDistanceSquared);
                     const invDistanceCubed = invDistance * invDistance * invDistance;
@@ -275,9 +309,139 @@ class OptimizedQuadTree {
             }
         }
         
+        if (counts) {
+            counts.cells = cells;
+            counts.direct = direct;
+        }
         return force;
     }
 
+    /**
+     * Softened gravitational potential at a position, with the same opening criterion
+     * as calculateForce. bodyIndex skips the body's own contribution.
+     */
+    calculatePotential(position, gravitationalConstant, softeningParameter, theta = 0.5, bodyIndex = -1) {
+        const softeningSquared = softeningParameter * softeningParameter;
+        const nodeStack = [this];
+        let potential = 0;
+        
+        while (nodeStack.length > 0) {
+            const node = nodeStack.pop();
+            if (node.totalMass === 0) continue;
+            
+            const dx = node.centerOfMass.x - position.x;
+            const dy = node.centerOfMass.y - position.y;
+            const distanceSquared = dx * dx + dy * dy;
+            const nodeSize = Math.max(node.bounds.width, node.bounds.height);
+            
+            if ((node.divided || node.bodyCount > 1) &&
+                nodeSize * nodeSize < theta * theta * distanceSquared && !node.contains(position)) {
+                potential -= gravitationalConstant * node.totalMass / Math.sqrt(distanceSquared + softeningSquared);
+            } else if (!node.divided) {
+                for (let i = 0; i < node.bodyCount; i++) {
+                    if (node.bodyIds[i] === bodyIndex) continue;
+                    
+                    const bdx = node.positions[i * 2] - position.x;
+                    const bdy = node.positions[i * 2 + 1] - position.y;
+                    potential -= gravitationalConstant * node.masses[i] / Math.sqrt(bdx * bdx + bdy * bdy + softeningSquared);
+                }
+            } else {
+                nodeStack.push(node.children.nw, node.children.ne, node.children.sw, node.children.se);
+            }
+        }
+        
+        return potential;
+    }
+
+    /**
+     * Fill in maxMass for this cell and every cell below it, from the masses array the
+     * body ids index into. Needed once per tree before findStrongestSource().
+     */
+    computeMaxMasses(masses) {
+        let maxMass = 0;
+        if (this.divided) {
+            for (const child of [this.children.nw, this.children.ne, this.children.sw, this.children.se]) {
+                maxMass = Math.max(maxMass, child.computeMaxMasses(masses));
+            }
+        } else {
+            for (let i = 0; i < this.bodyCount; i++) {
+                maxMass = Math.max(maxMass, masses[this.bodyIds[i]]);
+            }
+        }
+        this.maxMass = maxMass;
+        return maxMass;
+    }
+
+    /**
+     * Index of the body pulling hardest on a point (largest m / r²) among the bodies
+     * heavier than body bodyIndex, ties going to the lower index; -1 if there is none.
+     * masses is indexed by the ids the bodies were inserted with. A cell is skipped once
+     * its heaviest body at the cell's nearest edge could not beat the best pull so far,
+     * or when it holds nothing heavier. Children are visited most promising first so a
+     * strong pull is found early and prunes the rest of the walk.
+     */
+    findStrongestSource(position, masses, bodyIndex) {
+        const ownMass = masses[bodyIndex];
+        const nodeStack = [this];
+        const boundStack = [Infinity];
+        const children = new Array(4);
+        const bounds = new Float64Array(4);
+        let best = -1;
+        let bestPull = 0;
+        
+        while (nodeStack.length > 0) {
+            const node = nodeStack.pop();
+            if (boundStack.pop() <= bestPull) continue;
+            
+            if (node.divided) {
+                // Push in ascending order of each child's best possible pull
+                let count = 0;
+                for (const child of [node.children.nw, node.children.ne, node.children.sw, node.children.se]) {
+                    if (child.maxMass < ownMass) continue;
+                    const bound = OptimizedQuadTree.pullBound(child, position);
+                    if (bound <= bestPull) continue;
+                    
+                    let k = count++;
+                    while (k > 0 && bounds[k - 1] > bound) {
+                        bounds[k] = bounds[k - 1];
+                        children[k] = children[k - 1];
+                        k--;
+                    }
+                    bounds[k] = bound;
+                    children[k] = child;
+                }
+                for (let k = 0; k < count; k++) {
+                    nodeStack.push(children[k]);
+                    boundStack.push(bounds[k]);
+                }
+                continue;
+            }
+            
+            for (let i = 0; i < node.bodyCount; i++) {
+                const id = node.bodyIds[i];
+                const mass = masses[id];
+                if (id === bodyIndex || mass < ownMass || (mass === ownMass && id > bodyIndex)) continue;
+                
+                const dx = node.positions[i * 2] - position.x;
+                const dy = node.positions[i * 2 + 1] - position.y;
+                const pull = mass / (dx * dx + dy * dy);
+                if (pull > bestPull) {
+                    best = id;
+                    bestPull = pull;
+                }
+            }
+        }
+        
+        return best;
+    }
+
+    // Largest m / r² any single body in the cell could exert on a point
+    static pullBound(node, position) {
+        const gapX = Math.max(node.bounds.x - position.x, 0, position.x - node.bounds.x - node.bounds.width);
+        const gapY = Math.max(node.bounds.y - position.y, 0, position.y - node.bounds.y - node.bounds.height);
+        return node.maxMass / (gapX * gapX + gapY * gapY);
+    }
+
     /**
      * Optimized bounds checking
      */
@@ -294,6 +458,7 @@ class OptimizedQuadTree {
     clear() {
         this.bodyCount = 0;
         this.totalMass = 0;
+        this.maxMass = 0;
         this.centerOfMass.x = 0;
         this.centerOfMass.y = 0;
         this.divided = false;
@@ -307,6 +472,8 @@ class OptimizedQuadTree {
         let totalNodes = 1;
         let totalBodies = this.bodyCount;
         let maxDepthReached = this.depth;
+        let largestLeaf = this.divided ? 0 : this.bodyCount;
+        let bytes = this.positions.byteLength + this.masses.byteLength + this.bodyIds.byteLength;
         
         if (this.divided) {
             const childStats = [
@@ -320,6 +487,8 @@ class OptimizedQuadTree {
                 totalNodes += stats.nodes;
                 totalBodies += stats.bodies;
                 maxDepthReached = Math.max(maxDepthReached, stats.maxDepth);
+                largestLeaf = Math.max(largestLeaf, stats.largestLeaf);
+                bytes += stats.bytes;
             }
         }
         
@@ -327,6 +496,8 @@ class OptimizedQuadTree {
             nodes: totalNodes,
             bodies: totalBodies,
             maxDepth: maxDepthReached,
+            largestLeaf: largestLeaf,
+            bytes, // Typed arrays of this node and everything below it
             memoryUsage: {
                 positions: this.positions.byteLength,
                 masses: this.masses.byteLength,
@@ -343,49 +514,113 @@ class OptimizedBarnesHutForceCalculator {
     constructor() {
         this.tree = null;
         this.theta = 0.5; // Barnes-Hut approximation parameter
+        this.leafCapacity = PHYSICS_CONSTANTS.BARNES_HUT_LEAF_CAPACITY; // Bodies per leaf bucket
+        this.minCellSoftening = PHYSICS_CONSTANTS.BARNES_HUT_MIN_CELL_SOFTENING; // Smallest cell, in softening lengths
         this.stats = {
             forceCalculations: 0,
             treeConstructionTime: 0,
             forceCalculationTime: 0,
-            totalBodies: 0
+            totalBodies: 0,
+            cellInteractions: 0, // Cells taken as a single mass, summed over the bodies
+            directInteractions: 0 // Leaf bodies examined pair by pair
         };
+        this.costProfile = null; // Per-body counts, when the engine's profile is enabled
+        this.interactionCounts = { cells: 0, direct: 0 }; // Scratch for one body's walk
     }
 
     /**
      * Calculate forces for all bodies using optimized Barnes-Hut
+     * Pairs within nearFieldRadius are excluded (see OptimizedQuadTree.calculateForce)
      */
-    calculateForces(bodies, gravitationalConstant, softeningParameter) {
+    calculateForces(bodies, gravitationalConstant, softeningParameter, nearFieldRadius = 0) {
         const startTime = performance.now();
         
         // Reset statistics
         this.stats.forceCalculations = 0;
         this.stats.totalBodies = bodies.length;
+        this.stats.cellInteractions = 0;
+        this.stats.directInteractions = 0;
         
         // Build tree with optimized bounds calculation
         const constructionStart = performance.now();
-        this.buildTree(bodies);
+        this.buildTree(bodies, softeningParameter);
         this.stats.treeConstructionTime = performance.now() - constructionStart;
         
         // Calculate forces
         const forceStart = performance.now();
         const forces = new Array(bodies.length);
         
+        const counts = this.interactionCounts;
+        const profile = this.costProfile && this.costProfile.enabled ? this.costProfile : null;
+        let cells = 0;
+        let direct = 0;
         for (let i = 0; i < bodies.length; i++) {
-            forces[i] = this.tree.calculateForce(bodies[i], gravitationalConstant, softeningParameter, this.theta);
-            this.stats.forceCalculations++;
+            forces[i] = this.tree.calculateForce(bodies[i], gravitationalConstant, softeningParameter, this.theta, nearFieldRadius, i, counts);
+            cells += counts.cells;
+            direct += counts.direct;
+            if (profile) {
+                profile.cellInteractions[i] += counts.cells;
+                profile.directInteractions[i] += counts.direct;
+            }
         }
+        this.stats.forceCalculations += bodies.length;
+        this.stats.cellInteractions = cells;
+        this.stats.directInteractions = direct;
         
         this.stats.forceCalculationTime = performance.now() - forceStart;
         
         return forces;
     }
 
+    /**
+     * Accelerations for bodies[firstIndex..] only, e.g. bodies just appended to the list.
+     * The tree is built once over all bodies and walked only for the requested ones.
+     */
+    calculateForcesFrom(bodies, firstIndex, gravitationalConstant, softeningParameter) {
+        this.buildTree(bodies, softeningParameter);
+        
+        const forces = new Array(Math.max(0, bodies.length - firstIndex));
+        for (let i = firstIndex; i < bodies.length; i++) {
+            forces[i - firstIndex] = this.tree.calculateForce(bodies[i], gravitationalConstant, softeningParameter, this.theta, 0, i);
+        }
+        return forces;
+    }
+
+    /**
+     * Softened potential at every body from all the others (per unit mass)
+     */
+    calculatePotentials(bodies, gravitationalConstant, softeningParameter) {
+        const potentials = new Float64Array(bodies.length);
+        if (bodies.length === 0) return potentials;
+        
+        this.buildTree(bodies, softeningParameter);
+        for (let i = 0; i < bodies.length; i++) {
+            potentials[i] = this.tree.calculatePotential(bodies[i].position, gravitationalConstant, softeningParameter, this.theta, i);
+        }
+        return potentials;
+    }
+
     /**
      * Build tree with optimized bounds calculation
+     * Cells stop splitting at a fraction of the softening length, where the softened
+     * force barely varies, so clustered or coincident bodies cannot deepen the tree.
      */
-    buildTree(bodies) {
+    buildTree(bodies, softeningParameter = 0) {
         if (bodies.length === 0) return;
         
+        this.createTree(bodies, softeningParameter);
+        
+        // Insert all bodies
+        for (let i = 0; i < bodies.length; i++) {
+            this.tree.insert(bodies[i], i);
+        }
+    }
+
+    /**
+     * Empty root sized to the bodies' bounds, for callers that insert the bodies
+     * themselves (e.g. a few thousand at a time from a background job)
+     */
+    createTree(bodies, softeningParameter = 0) {
         // Calculate bounds more efficiently
         let minX = Infinity, maxX = -Infinity;
         let minY = Infinity, maxY = -Infinity;
@@ -397,8 +632,8 @@ class OptimizedBarnesHutForceCalculator {
             maxY = Math.max(maxY, body.position.y);
         }
         
-        // Add padding to bounds
-        const padding = Math.max(maxX - minX, maxY - minY) * 0.1;
+        // Add padding to bounds (never zero, so a single point still has an extent)
+        const padding = Math.max(Math.max(maxX - minX, maxY - minY) * 0.1, 1);
         const bounds = {
             x: minX - padding,
             y: minY - padding,
@@ -407,12 +642,9 @@ class OptimizedBarnesHutForceCalculator {
         };
         
         // Create new tree
-        this.tree = new OptimizedQuadTree(bounds);
-        
-        // Insert all bodies
-        for (let i = 0; i < bodies.length; i++) {
-            this.tree.insert(bodies[i], i);
-        }
+        const minCellSize = softeningParameter * this.minCellSoftening;
+        this.tree = new OptimizedQuadTree(bounds, this.leafCapacity, 0, 20, minCellSize);
+        return this.tree;
     }
 
     /**
@@ -0,0 +1,234 @@
+/**
+ * Short-term orbit preview
+ * When one body supplies nearly all of the pull on the preview body, its next orbit is
+ * the two-body conic about that body and is drawn straight from the state vector.
+ * Only genuinely multi-body spots fall back to integrating the preview body through
+ * the heaviest bodies of the field.
+ */
+
+class OrbitPreview {
+    /**
+     * Preview path for a body placed at previewBody's state. Returns
+     * { points: [{ position, velocity, stable, distance }], stable, collision,
+     *   completed, method: 'conic' | 'integrated', conic, perturbation }
+     */
+    static calculate(previewBody, bodies, physicsEngine) {
+        const gravitationalConstant = physicsEngine.gravitationalConstant;
+        const dominant = OrbitPreview.findDominantBody(previewBody, bodies, gravitationalConstant, physicsEngine.softeningParameter);
+        if (!dominant) {
+            return { points: [], stable: false, collision: false, completed: false, method: 'none' };
+        }
+        
+        if (dominant.share >= RENDERING_CONSTANTS.CONIC_PREVIEW_DOMINANCE) {
+            const conic = OrbitPreview.conic(previewBody, dominant.body, gravitationalConstant, RENDERING_CONSTANTS.CONIC_PREVIEW_POINTS);
+            if (conic) {
+                conic.perturbation = dominant.perturbation;
+                return conic;
+            }
+        }
+        
+        const integrated = OrbitPreview.integrate(previewBody, bodies, physicsEngine);
+        integrated.perturbation = dominant.perturbation;
+        return integrated;
+    }
+
+    /**
+     * Body with the strongest pull on the preview body, its share of the summed pull
+     * magnitudes, and the perturbation: the tidal acceleration of everything else (the
+     * difference between its pull on the preview body and on the primary) relative to
+     * the primary's own pull. One O(N) pass over the bodies.
+     */
+    static findDominantBody(previewBody, bodies, gravitationalConstant, softeningParameter = 0) {
+        const x = previewBody.position.x;
+        const y = previewBody.position.y;
+        const softeningSquared = softeningParameter * softeningParameter;
+        let primary = null;
+        let primaryPull = 0;
+        let totalPull = 0;
+        let ax = 0;
+        let ay = 0;
+        
+        for (const body of bodies) {
+            if (body === previewBody) continue;
+            const dx = body.position.x - x;
+            const dy = body.position.y - y;
+            const distanceSquared = dx * dx + dy * dy + softeningSquared;
+            if (distanceSquared === 0) continue;
+            
+            const pull = gravitationalConstant * body.mass / distanceSquared;
+            const scale = pull / Math.sqrt(distanceSquared);
+            ax += dx * scale;
+            ay += dy * scale;
+            totalPull += pull;
+            if (pull > primaryPull) {
+                primaryPull = pull;
+                primary = body;
+            }
+        }
+        if (!primary) return null;
+        
+        // Net pull of the others on the preview body and on the primary
+        const dx = primary.position.x - x;
+        const dy = primary.position.y - y;
+        const primaryScale = primaryPull / Math.sqrt(dx * dx + dy * dy + softeningSquared);
+        let otherX = ax - dx * primaryScale;
+        let otherY = ay - dy * primaryScale;
+        for (const body of bodies) {
+            if (body === previewBody || body === primary) continue;
+            const ox = body.position.x - primary.position.x;
+            const oy = body.position.y - primary.position.y;
+            const distanceSquared = ox * ox + oy * oy + softeningSquared;
+            if (distanceSquared === 0) continue;
+            const scale = gravitationalConstant * body.mass / (distanceSquared * Math.sqrt(distanceSquared));
+            otherX -= ox * scale;
+            otherY -= oy * scale;
+        }
+        
+        return {
+            body: primary,
+            share: primaryPull / totalPull,
+            perturbation: Math.hypot(otherX, otherY) / primaryPull
+        };
+    }
+
+    /**
+     * Two-body conic about the primary, sampled evenly in true anomaly from the current
+     * position: one full turn for ellipses, out to CONIC_PREVIEW_MAX_RADIUS times the
+     * starting distance for open orbits. The path stops where it meets the primary.
+     * Returns null for a purely radial start, which has no conic to draw.
+     */
+    static conic(previewBody, primary, gravitationalConstant, pointCount) {
+        const rx = previewBody.position.x - primary.position.x;
+        const ry = previewBody.position.y - primary.position.y;
+        const vx = previewBody.velocity.x - primary.velocity.x;
+        const vy = previewBody.velocity.y - primary.velocity.y;
+        const r = Math.sqrt(rx * rx + ry * ry);
+        const mu = gravitationalConstant * (primary.mass + previewBody.mass);
+        const angularMomentum = rx * vy - ry * vx;
+        if (r === 0 || mu <= 0 || Math.abs(angularMomentum) < 1e-9 * r * Math.sqrt(mu / r)) {
+            return null;
+        }
+        
+        const speedSquared = vx * vx + vy * vy;
+        const energy = 0.5 * speedSquared - mu / r;
+        const radialTerm = speedSquared - mu / r;
+        const rDotV = rx * vx + ry * vy;
+        const ex = (radialTerm * rx - rDotV * vx) / mu;
+        const ey = (radialTerm * ry - rDotV * vy) / mu;
+        const eccentricity = Math.sqrt(ex * ex + ey * ey);
+        const semiLatusRectum = angularMomentum * angularMomentum / mu;
+        
+        // Near-circular orbits have no periapsis direction; measure from the start instead
+        const periapsisAngle = eccentricity > 1e-9 ? Math.atan2(ey, ex) : Math.atan2(ry, rx);
+        const startAnomaly = Math.atan2(ry, rx) - periapsisAngle;
+        const direction = Math.sign(angularMomentum);
+        const closed = eccentricity < 1;
+        
+        // Anomaly swept: a full turn, or up to where an open path reaches the maximum radius
+        let sweep = 2 * Math.PI;
+        if (!closed) {
+            const maxRadius = r * RENDERING_CONSTANTS.CONIC_PREVIEW_MAX_RADIUS;
+            const endAnomaly = Math.acos(Math.max(-1, Math.min(1, (semiLatusRectum / maxRadius - 1) / eccentricity)));
+            const current = Math.atan2(Math.sin(startAnomaly), Math.cos(startAnomaly)) * direction;
+            sweep = Math.max(0, endAnomaly - current);
+        }
+        
+        const reach = primary.radius + previewBody.radius;
+        const points = [];
+        let collision = false;
+        for (let k = 0; k <= pointCount; k++) {
+            const anomaly = startAnomaly + direction * sweep * k / pointCount;
+            const distance = semiLatusRectum / (1 + eccentricity * Math.cos(anomaly));
+            const angle = anomaly + periapsisAngle;
+            collision = distance < reach;
+            
+            points.push({
+                position: new Vector2D(
+                    primary.position.x + distance * Math.cos(angle),
+                    primary.position.y + distance * Math.sin(angle)
+                ),
+                velocity: Math.sqrt(Math.max(0, 2 * (energy + mu / distance))),
+                stable: closed && !collision,
+                distance
+            });
+            if (collision) break;
+        }
+        
+        const semiMajorAxis = closed ? -mu / (2 * energy) : Infinity;
+        return {
+            points,
+            stable: closed && !collision,
+            collision,
+            completed: closed && !collision,
+            method: 'conic',
+            conic: {
+                primaryId: primary.id,
+                eccentricity,
+                semiMajorAxis,
+                periapsis: semiLatusRectum / (1 + eccentricity),
+                apoapsis: closed ? semiLatusRectum / (1 - eccentricity) : Infinity,
+                period: closed ? 2 * Math.PI * Math.sqrt(Math.pow(semiMajorAxis, 3) / mu) : Infinity
+            }
+        };
+    }
+
+    /**
+     * Multi-body fallback: a short run of the 'orbit-prediction' job, synchronously,
+     * through the heaviest bodies of the field
+     */
+    static integrate(previewBody, bodies, physicsEngine) {
+        const n = bodies.length;
+        const payload = {
+            x: new Float64Array(n), y: new Float64Array(n),
+            vx: new Float64Array(n), vy: new Float64Array(n),
+            mass: new Float64Array(n), radius: new Float64Array(n),
+            test: {
+                x: previewBody.position.x,
+                y: previewBody.position.y,
+                vx: previewBody.velocity.x,
+                vy: previewBody.velocity.y,
+                mass: previewBody.mass,
+                radius: previewBody.radius
+            },
+            gravitationalConstant: physicsEngine.gravitationalConstant,
+            softeningParameter: physicsEngine.softeningParameter,
+            timeStep: RENDERING_CONSTANTS.PREDICTION_TIME_STEP,
+            steps: RENDERING_CONSTANTS.PREVIEW_INTEGRATION_STEPS,
+            maxPoints: RENDERING_CONSTANTS.CONIC_PREVIEW_POINTS,
+            maxFieldBodies: RENDERING_CONSTANTS.PREVIEW_FIELD_BODIES
+        };
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            payload.x[i] = body.position.x;
+            payload.y[i] = body.position.y;
+            payload.vx[i] = body.velocity.x;
+            payload.vy[i] = body.velocity.y;
+            payload.mass[i] = body.mass;
+            payload.radius[i] = body.radius;
+        }
+        
+        const job = SCHEDULER_JOBS['orbit-prediction'](payload);
+        let step = job.next();
+        while (!step.done) {
+            step = job.next();
+        }
+        const result = step.value;
+        
+        return {
+            points: result.points.map(point => ({
+                position: new Vector2D(point.x, point.y),
+                stable: !result.collision,
+                distance: 0
+            })),
+            stable: false,
+            collision: result.collision,
+            completed: false,
+            method: 'integrated'
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { OrbitPreview };
+}
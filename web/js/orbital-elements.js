@@ -0,0 +1,244 @@
+/**
+ * Batch orbital elements
+ * Assigns every body a dominant attractor and computes its osculating two-body
+ * elements about it, for all bodies at once over packed arrays:
+ *   1. Strongest pull: the heavier body with the largest m / r², from a
+ *      branch-and-bound walk of a Barnes-Hut tree.
+ *   2. Hill spheres: a body with a primary at distance d has r_H = d (m / 3M)^(1/3).
+ *      A body outside its primary's Hill sphere, or not bound to it, moves up to the
+ *      primary's attractor, and a body bound inside the Hill sphere of any heavier one
+ *      (the smallest such sphere wins) orbits that body, so moons go to their planet
+ *      and belt bodies to the star.
+ *   3. Semi-major axis, eccentricity, argument of periapsis and period from the
+ *      relative state, plus histograms over the bound bodies.
+ * The whole survey is O(N log N) plus the pairs of overlapping Hill spheres, and runs
+ * as the 'orbital-elements' scheduler job.
+ */
+
+class OrbitalElements {
+    /**
+     * Generator behind the 'orbital-elements' job. Yields progress in [0, 1].
+     * payload: { x, y, vx, vy, mass (Float64Array), gravitationalConstant, bins }
+     * Per-body results are arrays in payload order; attractor is -1 for bodies with no
+     * heavier body, whose elements are NaN.
+     */
+    static *compute(payload) {
+        const startTime = performance.now();
+        const { x, y, vx, vy, mass, gravitationalConstant } = payload;
+        const n = mass.length;
+        const bodiesPerSlice = 2000;
+        
+        // 1. Strongest heavier pull
+        const points = new Array(n);
+        for (let i = 0; i < n; i++) {
+            points[i] = { position: { x: x[i], y: y[i] }, mass: mass[i] };
+        }
+        const tree = new OptimizedBarnesHutForceCalculator().createTree(points);
+        for (let i = 0; i < n; i++) {
+            tree.insert(points[i], i);
+            if ((i + 1) % bodiesPerSlice === 0) yield 0.2 * (i + 1) / n;
+        }
+        tree.computeMaxMasses(mass);
+        
+        const attractor = new Int32Array(n);
+        for (let i = 0; i < n; i++) {
+            attractor[i] = tree.findStrongestSource(points[i].position, mass, i);
+            if ((i + 1) % bodiesPerSlice === 0) yield 0.2 + 0.4 * (i + 1) / n;
+        }
+        
+        // 2. Hill spheres. In a dense swarm the strongest pull is often a slightly heavier
+        // neighbour the body just passes by, so heavier bodies are settled first and each
+        // body climbs from its primary to the primary's own attractor until it sits inside
+        // a Hill sphere it is also bound in, or reaches a root body.
+        const boundTo = (i, p) => {
+            const dvx = vx[i] - vx[p];
+            const dvy = vy[i] - vy[p];
+            return 0.5 * (dvx * dvx + dvy * dvy) <
+                gravitationalConstant * (mass[i] + mass[p]) / Math.hypot(x[i] - x[p], y[i] - y[p]);
+        };
+        const order = new Uint32Array(n);
+        for (let i = 0; i < n; i++) order[i] = i;
+        order.sort((a, b) => mass[b] - mass[a] || a - b);
+        
+        const hillRadius = new Float64Array(n);
+        let smallestHill = Infinity;
+        for (let k = 0; k < n; k++) {
+            const i = order[k];
+            let p = attractor[i];
+            if (p < 0) continue;
+            while (attractor[p] >= 0 && (Math.hypot(x[i] - x[p], y[i] - y[p]) >= hillRadius[p] || !boundTo(i, p))) {
+                p = attractor[p];
+            }
+            attractor[i] = p;
+            hillRadius[i] = Math.hypot(x[i] - x[p], y[i] - y[p]) * Math.cbrt(mass[i] / (3 * mass[p]));
+            if (hillRadius[i] > 0) smallestHill = Math.min(smallestHill, hillRadius[i]);
+        }
+        yield 0.65;
+        
+        // Any heavier body whose Hill sphere encloses a body bound to it, not only those
+        // on its chain, can take it over; the smallest such sphere wins
+        if (smallestHill < Infinity) {
+            // Bodies without a sphere of their own still need an extent to be placed in the grid
+            const radii = new Float64Array(n);
+            for (let i = 0; i < n; i++) {
+                radii[i] = Math.max(hillRadius[i], smallestHill);
+            }
+            const grid = new MultiLevelGrid();
+            grid.build(x, y, radii, n);
+            
+            // Radius of the sphere each body was placed in; Infinity for a root's pull
+            const hostRadius = new Float64Array(n).fill(Infinity);
+            for (let i = 0; i < n; i++) {
+                const p = attractor[i];
+                if (p >= 0 && attractor[p] >= 0) hostRadius[i] = hillRadius[p];
+            }
+            const host = (child, parent) => {
+                const parentHill = hillRadius[parent];
+                if (parentHill <= 0 || parentHill >= hostRadius[child]) return;
+                if (mass[parent] < mass[child] || (mass[parent] === mass[child] && parent > child)) return;
+                
+                const dx = x[child] - x[parent];
+                const dy = y[child] - y[parent];
+                if (dx * dx + dy * dy < parentHill * parentHill && boundTo(child, parent)) {
+                    attractor[child] = parent;
+                    hostRadius[child] = parentHill;
+                }
+            };
+            
+            for (let first = 0; first < n; first += bodiesPerSlice) {
+                const last = Math.min(n, first + bodiesPerSlice);
+                grid.forEachCandidatePair((i, j) => {
+                    host(i, j);
+                    host(j, i);
+                }, first, last);
+                yield 0.65 + 0.25 * last / n;
+            }
+        }
+        
+        // 3. Elements relative to the attractor
+        const semiMajorAxis = new Float64Array(n);
+        const eccentricity = new Float64Array(n);
+        const argumentOfPeriapsis = new Float64Array(n);
+        const period = new Float64Array(n);
+        const bound = new Uint8Array(n);
+        let boundCount = 0;
+        
+        for (let i = 0; i < n; i++) {
+            const p = attractor[i];
+            if (p < 0) {
+                semiMajorAxis[i] = NaN;
+                eccentricity[i] = NaN;
+                argumentOfPeriapsis[i] = NaN;
+                period[i] = NaN;
+                continue;
+            }
+            
+            const rx = x[i] - x[p];
+            const ry = y[i] - y[p];
+            const ux = vx[i] - vx[p];
+            const uy = vy[i] - vy[p];
+            const r = Math.sqrt(rx * rx + ry * ry);
+            const speedSquared = ux * ux + uy * uy;
+            const mu = gravitationalConstant * (mass[i] + mass[p]);
+            const energy = 0.5 * speedSquared - mu / r;
+            
+            // Eccentricity vector e = ((v² - μ/r) r - (r·v) v) / μ
+            const radialTerm = speedSquared - mu / r;
+            const rDotV = rx * ux + ry * uy;
+            const ex = (radialTerm * rx - rDotV * ux) / mu;
+            const ey = (radialTerm * ry - rDotV * uy) / mu;
+            
+            eccentricity[i] = Math.sqrt(ex * ex + ey * ey);
+            argumentOfPeriapsis[i] = Math.atan2(ey, ex);
+            if (energy < 0) {
+                semiMajorAxis[i] = -mu / (2 * energy);
+                period[i] = 2 * Math.PI * Math.sqrt(Math.pow(semiMajorAxis[i], 3) / mu);
+                bound[i] = 1;
+                boundCount++;
+            } else {
+                semiMajorAxis[i] = Infinity;
+                period[i] = Infinity;
+            }
+        }
+        
+        yield 0.95;
+        
+        const bins = payload.bins || PHYSICS_CONSTANTS.ORBIT_HISTOGRAM_BINS;
+        const reference = OrbitalElements.findReference(attractor, mass, bound);
+        
+        return {
+            attractor,
+            semiMajorAxis,
+            eccentricity,
+            argumentOfPeriapsis,
+            period,
+            bound,
+            boundCount,
+            reference,
+            histograms: OrbitalElements.buildHistograms(attractor, semiMajorAxis, eccentricity, period, bound, reference, bins),
+            elapsed: performance.now() - startTime
+        };
+    }
+
+    /**
+     * The heaviest bound body orbiting a root body (one with no attractor), e.g. the
+     * giant planet whose resonances shape a belt; -1 when there is none
+     */
+    static findReference(attractor, mass, bound) {
+        let reference = -1;
+        for (let i = 0; i < attractor.length; i++) {
+            const p = attractor[i];
+            if (p < 0 || !bound[i] || attractor[p] >= 0) continue;
+            if (reference < 0 || mass[i] > mass[reference]) reference = i;
+        }
+        return reference;
+    }
+
+    /**
+     * Histograms over bound bodies: semi-major axis (up to the 98th percentile),
+     * eccentricity, and period relative to the reference body for bodies sharing its
+     * attractor, where mean-motion resonances show up as peaks and gaps
+     */
+    static buildHistograms(attractor, semiMajorAxis, eccentricity, period, bound, reference, bins) {
+        const n = attractor.length;
+        const boundAxes = [];
+        for (let i = 0; i < n; i++) {
+            if (bound[i]) boundAxes.push(semiMajorAxis[i]);
+        }
+        boundAxes.sort((a, b) => a - b);
+        const maxAxis = boundAxes.length > 0 ? boundAxes[Math.floor((boundAxes.length - 1) * 0.98)] : 1;
+        
+        const histograms = {
+            semiMajorAxis: OrbitalElements.createHistogram(0, maxAxis, bins),
+            eccentricity: OrbitalElements.createHistogram(0, 1, bins),
+            periodRatio: reference >= 0 ? OrbitalElements.createHistogram(0, 3, bins * 2) : null
+        };
+        
+        for (let i = 0; i < n; i++) {
+            if (!bound[i]) continue;
+            OrbitalElements.addToHistogram(histograms.semiMajorAxis, semiMajorAxis[i]);
+            OrbitalElements.addToHistogram(histograms.eccentricity, eccentricity[i]);
+            if (histograms.periodRatio && i !== reference && attractor[i] === attractor[reference]) {
+                OrbitalElements.addToHistogram(histograms.periodRatio, period[i] / period[reference]);
+            }
+        }
+        
+        return histograms;
+    }
+
+    static createHistogram(min, max, bins) {
+        return { min, max: max > min ? max : min + 1, counts: new Uint32Array(bins) };
+    }
+
+    // Values outside [min, max) are left out
+    static addToHistogram(histogram, value) {
+        const bins = histogram.counts.length;
+        const bin = Math.floor((value - histogram.min) / (histogram.max - histogram.min) * bins);
+        if (bin >= 0 && bin < bins) histogram.counts[bin]++;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { OrbitalElements };
+}
@@ -1,83 +1,85 @@
 /**
  * Web Worker for background physics calculations
- * Allows heavy computations to run without blocking the UI
+ * Hosts the same PhysicsEngine the main thread uses, so integrators, collision
+ * handling, adaptive stepping and force-calculation optimizations behave the
+ * same in both places. Bodies persist between steps; the main thread only
+ * sends its edits and elapsed time, then applies the returned snapshot.
  */
 
-// Import necessary modules (note: Web Workers have limited access)
-importScripts('vector2d.js', 'body.js', 'integrator.js', 'barnes-hut.js');
+// Import the shared simulation modules (note: Web Workers have limited access)
+importScripts(
+    'constants.js',
+    'diagnostics.js',
+    'memory-ledger.js',
+    'vector2d.js',
+    'trail.js',
+    'body.js',
+    'integrator.js',
+    'barnes-hut.js',
+    'optimized-barnes-hut.js',
+    'spatial-grid.js',
+    'neighbor-list.js',
+    'collision-islands.js',
+    'contact-solver.js',
+    'force-fields.js',
+    'kernel-generator.js',
+    'group-finder.js',
+    'orbital-elements.js',
+    'scheduler.js',
+    'escapers.js',
+    'cost-profile.js',
+    'physics.js'
+);
+
+// Bodies created here (e.g. by inelastic merges) draw ids from a separate range.
+// The main thread never advances its own counter into this range, so the two sides
+// cannot hand out the same id even while a step is in flight.
+const WORKER_BODY_ID_BASE = 1e9;
 
 class PhysicsWorker {
     constructor() {
-        this.gravitationalConstant = 100.0;
-        this.softeningParameter = 20.0;
-        this.integrator = new Integrator();
-        this.barnesHutTheta = 0.5;
+        this.engine = new PhysicsEngine();
+        this.engine.sampleTrails = false; // Trails are sampled on the main thread
+        this.bodies = [];            // Persistent body list, in main-thread order
+        this.bodiesById = new Map(); // id -> Body for reconciliation
+        
+        Body.idCounter = Math.max(Body.idCounter || 0, WORKER_BODY_ID_BASE);
         
         console.log('PhysicsWorker initialized');
     }
-    
-    // Calculate forces using Barnes-Hut algorithm
-    calculateForcesBarnesHut(bodies) {
-        // Reset forces
-        bodies.forEach(body => {
-            body.resetForce();
-            body.potentialEnergy = 0;
-        });
-        
-        // Build quadtree
-        const bounds = this.calculateBounds(bodies);
-        const barnesHut = new QuadTree(bounds, 1);
-        
-        // Insert all bodies
-        bodies.forEach(body => barnesHut.insert(body));
-        
-        // Calculate forces for each body
-        bodies.forEach(body => {
-            barnesHut.calculateForce(body, this.gravitationalConstant, this.softeningParameter, this.barnesHutTheta);
-        });
+
+    // Apply main-thread physics settings to the hosted engine
+    configure(config) {
+        if (!config) return;
         
-        return bodies;
-    }
-    
-    // Calculate bounding box for all bodies
-    calculateBounds(bodies) {
-        if (bodies.length === 0) {
-            return { x: -1000, y: -1000, width: 2000, height: 2000 };
+        const workerConfig = { ...config };
+        // GPU.js is not available in the worker; Barnes-Hut is the closest CPU equivalent
+        if (workerConfig.forceCalculationMethod === 'gpu') {
+            workerConfig.forceCalculationMethod = 'barnes-hut';
         }
+        // The escaper archive is kept on the main thread, which drops archived bodies from its next step
+        workerConfig.escaperArchival = false;
         
-        let minX = bodies[0].position.x;
-        let maxX = bodies[0].position.x;
-        let minY = bodies[0].position.y;
-        let maxY = bodies[0].position.y;
-        
-        bodies.forEach(body => {
-            minX = Math.min(minX, body.position.x);
-            maxX = Math.max(maxX, body.position.x);
-            minY = Math.min(minY, body.position.y);
-            maxY = Math.max(maxY, body.position.y);
-        });
-        
-        // Add padding
-        const padding = Math.max(maxX - minX, maxY - minY) * 0.1;
-        return {
-            x: minX - padding,
-            y: minY - padding,
-            width: (maxX - minX) + 2 * padding,
-            height: (maxY - minY) + 2 * padding
-        };
+        this.engine.setConfiguration(workerConfig);
     }
-    
-    // Perform physics simulation step
-    simulateStep(bodiesData, deltaTime, config) {
-        // Validate input parameters
-        if (!Array.isArray(bodiesData) || typeof deltaTime !== 'number' || deltaTime <= 0 || !isFinite(deltaTime)) {
-            throw new Error('Invalid simulation parameters');
+
+    // Reconcile the main thread's view of the bodies with the persistent worker copies.
+    // Values equal to our last snapshot are untouched, so integrator history survives;
+    // anything the user edited in the meantime overrides the worker state.
+    syncBodies(bodiesData) {
+        if (!Array.isArray(bodiesData)) {
+            throw new Error('Invalid body list');
         }
         
-        // Reconstruct body objects from serialized data with validation
-        const bodies = bodiesData.map((bodyData, index) => {
+        const nextBodies = new Array(bodiesData.length);
+        const nextById = new Map();
+        let maxWorkerId = 0; // Highest id from this range already in use
+        
+        for (let index = 0; index < bodiesData.length; index++) {
+            const bodyData = bodiesData[index];
+            
             // Validate body data structure
-            if (!bodyData || !bodyData.position || !bodyData.velocity || 
+            if (!bodyData || !bodyData.position || !bodyData.velocity ||
                 typeof bodyData.mass !== 'number' || bodyData.mass <= 0) {
                 throw new Error(`Invalid body data at index ${index}`);
             }
@@ -89,119 +91,154 @@ class PhysicsWorker {
                 throw new Error(`Non-finite values in body data at index ${index}`);
             }
             
-            const body = new Body(
-                new Vector2D(bodyData.position.x, bodyData.position.y),
-                new Vector2D(bodyData.velocity.x, bodyData.velocity.y),
-                bodyData.mass,
-                bodyData.color || '#ff4757',
-                bodyData.trailLength || 50
-            );
-            body.id = bodyData.id || index;
-            body.trail = Array.isArray(bodyData.trail) ? bodyData.trail : [];
-            return body;
-        });
-        
-        // Calculate forces
-        if (config.forceMethod === 'barnes-hut' && bodies.length > 5) {
-            this.calculateForcesBarnesHut(bodies);
-        } else {
-            this.calculateForcesNaive(bodies);
+            let body = this.bodiesById.get(bodyData.id);
+            
+            if (!body) {
+                body = new Body(
+                    new Vector2D(bodyData.position.x, bodyData.position.y),
+                    new Vector2D(bodyData.velocity.x, bodyData.velocity.y),
+                    bodyData.mass,
+                    bodyData.color || '#ff4757',
+                    bodyData.trailLength || RENDERING_CONSTANTS.DEFAULT_TRAIL_LENGTH
+                );
+                body.id = bodyData.id;
+            } else {
+                if (body.position.x !== bodyData.position.x || body.position.y !== bodyData.position.y) {
+                    // Moved on the main thread (e.g. dragged): shift history so no velocity is implied
+                    const shiftX = bodyData.position.x - body.position.x;
+                    const shiftY = bodyData.position.y - body.position.y;
+                    body.position.x = bodyData.position.x;
+                    body.position.y = bodyData.position.y;
+                    if (body.lastPosition) {
+                        body.lastPosition.x += shiftX;
+                        body.lastPosition.y += shiftY;
+                    }
+                    this.engine.invalidateCachedAccelerations();
+                }
+                
+                body.velocity.x = bodyData.velocity.x;
+                body.velocity.y = bodyData.velocity.y;
+                
+                if (body.mass !== bodyData.mass) {
+                    body.mass = bodyData.mass;
+                    body.updateRadius();
+                }
+                
+                body.color = bodyData.color || body.color;
+            }
+            
+            body.fixed = !!bodyData.fixed;
+            body.beingDragged = !!bodyData.beingDragged;
+            
+            nextBodies[index] = body;
+            nextById.set(body.id, body);
+            if (body.id >= WORKER_BODY_ID_BASE) maxWorkerId = Math.max(maxWorkerId, body.id);
         }
         
-        // Update positions using RK4 integrator
-        if (config.integrationMethod === 'rk4') {
-            this.integrator.integrateRK4(bodies, deltaTime, (bodies) => {
-                if (config.forceMethod === 'barnes-hut' && bodies.length > 8) {
-                    this.calculateForcesBarnesHut(bodies);
-                } else {
-                    this.calculateForcesNaive(bodies);
-                }
-            });
-        } else {
-            // Fallback to simple Verlet integration
-            bodies.forEach(body => body.update(deltaTime));
+        this.bodies = nextBodies;
+        this.bodiesById = nextById;
+        
+        // A new worker must not reissue ids an earlier one handed out; main-thread ids
+        // never move the counter
+        Body.idCounter = Math.max(Body.idCounter, maxWorkerId);
+    }
+
+    // Advance the hosted engine and describe the resulting state
+    step(deltaTime) {
+        if (typeof deltaTime !== 'number' || deltaTime <= 0 || !isFinite(deltaTime)) {
+            throw new Error('Invalid simulation parameters');
         }
         
-        // Calculate energy
-        const energy = this.calculateTotalEnergy(bodies);
+        this.engine.deferPotentialEnergy = this.bodies.length > PHYSICS_CONSTANTS.DEFERRED_ENERGY_BODY_THRESHOLD;
+        this.engine.update(this.bodies, deltaTime);
+        this.updateEnergyAudit();
+        
+        // Collisions may have merged or replaced bodies; rebuild the id index
+        this.bodiesById = new Map();
+        const serializedBodies = new Array(this.bodies.length);
         
-        // Serialize bodies back to transferable data with validation
-        const serializedBodies = bodies.map(body => {
+        for (let i = 0; i < this.bodies.length; i++) {
+            const body = this.bodies[i];
+            this.bodiesById.set(body.id, body);
+            
             // Validate body state before serialization
             if (!body.validateState()) {
                 body.correctState();
             }
             
-            return {
+            serializedBodies[i] = {
                 id: body.id,
                 position: { x: body.position.x, y: body.position.y },
                 velocity: { x: body.velocity.x, y: body.velocity.y },
                 mass: body.mass,
                 radius: body.radius,
                 color: body.color,
-                trail: body.trail,
+                trailLength: body.maxTrailLength,
                 kineticEnergy: body.kineticEnergy || 0,
                 potentialEnergy: body.potentialEnergy || 0
             };
-        });
+        }
         
         return {
             bodies: serializedBodies,
-            energy: energy
+            energy: this.engine.getEnergyStats(),
+            performance: this.engine.getPerformanceStats(),
+            barnesHutStats: this.engine.barnesHutStats || null,
+            simulationTime: this.engine.simulationTime,
+            diagnostics: Diagnostics.takeSnapshot(),
+            costProfile: this.engine.costProfile.snapshot()
         };
     }
-    
-    // Calculate forces using naive O(N²) method
-    calculateForcesNaive(bodies) {
-        // Reset forces
-        bodies.forEach(body => body.resetForce());
-        
-        for (let i = 0; i < bodies.length; i++) {
-            for (let j = i + 1; j < bodies.length; j++) {
-                const body1 = bodies[i];
-                const body2 = bodies[j];
-                
-                const force = body1.calculateGravitationalForce(
-                    body2, 
-                    this.gravitationalConstant, 
-                    this.softeningParameter
-                );
-                
-                body1.applyForce(force);
-                body2.applyForce(force.multiply(-1));
-            }
-        }
+
+    // Follow the main thread's scene changes: the old scene's audit no longer applies
+    setEnergyGeneration(generation) {
+        if (typeof generation !== 'number' || generation === this.engine.energyGeneration) return;
+        jobScheduler.cancelKey('energy-audit');
+        this.engine.resetEnergyTracking(generation);
     }
-    
-    // Calculate total system energy
-    calculateTotalEnergy(bodies) {
-        let totalKinetic = 0;
-        let totalPotential = 0;
-        
-        // Calculate kinetic energy
-        bodies.forEach(body => {
-            const kineticEnergy = 0.5 * body.mass * body.velocity.magnitudeSquared();
-            totalKinetic += kineticEnergy;
-            body.kineticEnergy = kineticEnergy;
-        });
+
+    // Large scenes take their potential energy from an audit job run between steps (as
+    // the main thread does), instead of the O(N²) sum inside every step
+    updateEnergyAudit() {
+        if (!this.engine.deferPotentialEnergy || jobScheduler.hasPendingTasks('energy-audit')) return;
         
-        // Calculate potential energy
-        for (let i = 0; i < bodies.length; i++) {
-            for (let j = i + 1; j < bodies.length; j++) {
-                const body1 = bodies[i];
-                const body2 = bodies[j];
-                const distance = body1.position.distance(body2.position);
-                const safeDist = Math.max(distance, this.softeningParameter);
-                
-                const potentialEnergy = -this.gravitationalConstant * body1.mass * body2.mass / safeDist;
-                totalPotential += potentialEnergy;
-            }
+        const n = this.bodies.length;
+        const x = new Float64Array(n);
+        const y = new Float64Array(n);
+        const mass = new Float64Array(n);
+        for (let i = 0; i < n; i++) {
+            x[i] = this.bodies[i].position.x;
+            y[i] = this.bodies[i].position.y;
+            mass[i] = this.bodies[i].mass;
         }
         
+        const generation = this.engine.energyGeneration;
+        jobScheduler.schedule({
+            type: 'energy-audit',
+            payload: {
+                x, y, mass,
+                gravitationalConstant: this.engine.gravitationalConstant,
+                softeningParameter: this.engine.softeningParameter
+            }
+        }, {
+            key: 'energy-audit',
+            priority: TASK_PRIORITY.LOW,
+            onComplete: result => {
+                if (result.bodyCount === this.bodies.length) {
+                    this.engine.setDeferredPotentialEnergy(result.potentialEnergy, this.bodies, generation);
+                }
+            }
+        });
+        scheduleJobPump();
+    }
+
+    // Engine buffers plus an estimate for the worker's copies of the bodies
+    getMemoryUsage() {
+        const engine = this.engine.getMemoryUsage();
+        const bodyObjects = this.bodies.length * RENDERING_CONSTANTS.MEMORY_BODY_OBJECTS;
         return {
-            kinetic: totalKinetic,
-            potential: totalPotential,
-            total: totalKinetic + totalPotential
+            bytes: engine.bytes + bodyObjects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES,
+            objects: engine.objects + bodyObjects
         };
     }
 }
@@ -209,47 +246,99 @@ class PhysicsWorker {
 // Create worker instance
 const physicsWorker = new PhysicsWorker();
 
+// Jobs offloaded by the main thread's TaskScheduler run here in short slices, so
+// 'step' messages queued behind them are still answered promptly
+const jobScheduler = new TaskScheduler(PHYSICS_CONSTANTS.SCHEDULER_WORKER_SLICE);
+const jobHandles = new Map(); // main-thread jobId -> local task handle
+let jobPumpScheduled = false;
+
+function pumpJobs() {
+    jobPumpScheduled = false;
+    jobScheduler.run();
+    if (jobScheduler.hasPendingTasks()) {
+        scheduleJobPump();
+    }
+}
+
+function scheduleJobPump() {
+    if (!jobPumpScheduled) {
+        jobPumpScheduled = true;
+        setTimeout(pumpJobs, 0);
+    }
+}
+
+function startJob({ jobId, jobType, payload }) {
+    if (!SCHEDULER_JOBS[jobType]) {
+        self.postMessage({ type: 'job-error', data: { jobId, message: `Unknown job type: ${jobType}` } });
+        return;
+    }
+
+    const handle = jobScheduler.schedule({ type: jobType, payload }, {
+        onProgress: progress => {
+            self.postMessage({ type: 'job-progress', data: { jobId, progress } });
+        },
+        onComplete: result => {
+            jobHandles.delete(jobId);
+            self.postMessage({ type: 'job-result', data: { jobId, result } });
+        },
+        onError: error => {
+            jobHandles.delete(jobId);
+            self.postMessage({ type: 'job-error', data: { jobId, message: error.message } });
+        }
+    });
+    jobHandles.set(jobId, handle);
+    scheduleJobPump();
+}
+
 // Handle messages from main thread
 self.onmessage = function(e) {
     const { type, data } = e.data;
-    
+
     try {
         switch (type) {
-            case 'simulate':
-                const result = physicsWorker.simulateStep(
-                    data.bodies,
-                    data.deltaTime,
-                    data.config
-                );
+            case 'step':
+                physicsWorker.configure(data.config);
+                physicsWorker.setEnergyGeneration(data.energyGeneration);
+                if (data.bodies) {
+                    physicsWorker.syncBodies(data.bodies);
+                }
+                const result = physicsWorker.step(data.deltaTime);
+                result.sequence = data.sequence;
+                if (data.reportMemory) {
+                    result.memory = physicsWorker.getMemoryUsage();
+                }
                 self.postMessage({
                     type: 'simulation-result',
                     data: result
                 });
                 break;
-                
-            case 'configure':
-                if (data.gravitationalConstant !== undefined) {
-                    physicsWorker.gravitationalConstant = data.gravitationalConstant;
-                }
-                if (data.softeningParameter !== undefined) {
-                    physicsWorker.softeningParameter = data.softeningParameter;
-                }
-                if (data.barnesHutTheta !== undefined) {
-                    physicsWorker.barnesHutTheta = data.barnesHutTheta;
+            
+            case 'job':
+                startJob(data);
+                break;
+            
+            case 'job-cancel':
+                if (jobHandles.has(data.jobId)) {
+                    jobHandles.get(data.jobId).cancel();
+                    jobHandles.delete(data.jobId);
                 }
+                break;
+            
+            case 'configure':
+                physicsWorker.configure(data);
                 self.postMessage({
                     type: 'configuration-updated',
                     data: { success: true }
                 });
                 break;
-                
+            
             default:
                 console.warn('Unknown message type:', type);
         }
     } catch (error) {
         self.postMessage({
             type: 'error',
-            data: { 
+            data: {
                 message: error.message,
                 stack: error.stack
             }
@@ -9,6 +9,7 @@ class PhysicsEngine {
         this.timeScale = 1.0;
         this.integrationMethod = 'verlet'; // 'verlet', 'euler', 'rk4' - Verlet is more stable for runtime additions
         this.forceCalculationMethod = 'barnes-hut'; // 'naive', 'barnes-hut', or 'gpu'
+        this.sampleTrails = true; // Record trail points after each frame (the worker leaves this to the main thread)
         
         // Time accumulator for consistent physics
         this.timeAccumulator = 0.0;
@@ -24,19 +25,78 @@ class PhysicsEngine {
         this.energyHistory = [];
         this.maxEnergyHistory = 1000;
         this.energyCacheValid = false;
+        this.deferPotentialEnergy = false; // Potential energy is supplied by a scheduled audit instead
+        this.deferredPotentialEnergy = null; // Latest audited potential energy, null until this scene's first audit
+        this.potentialEnergyKnown = false; // totalPotentialEnergy describes the current scene
+        this.energyGeneration = 0; // Bumped on every scene change; audits carry the generation they measured
         
         // Performance tracking
         this.lastFrameTime = 0;
         this.physicsTime = 0;
         this.forceCalculationTime = 0;
         this.integrationTime = 0;
+        // Totals over the steps of the last update, for the flight recorder
+        this.frameTimings = { steps: 0, treeBuild: 0, treeWalk: 0, collisions: 0 };
+        // Per-body interaction counts for the last step, when profiling is on
+        this.costProfile = new CostProfile();
         
         // Initialize advanced components
         this.integrator = new Integrator();
         this.barnesHut = null;
         this.optimizedBarnesHut = new OptimizedBarnesHutForceCalculator();
+        this.optimizedBarnesHut.costProfile = this.costProfile;
         this.barnesHutTheta = PHYSICS_CONSTANTS.BARNES_HUT_THETA;
         
+        // External fields (halos, drag, rotating frame) added in the force pass
+        this.forceFields = new ForceFieldSet();
+        
+        // Direct-sum loops generated per configuration and cached by key
+        this.useSpecializedKernels = true;
+        this.kernelGenerator = new ForceKernelGenerator();
+        this.kernelOptions = {}; // Reused by every direct-sum pass
+        this.kernelBuffers = null;
+        this.trackBodyPotentialEnergy = true; // Per-body potential energy from the direct sum
+        
+        // Unbound bodies far from the system leave the active set and move analytically
+        this.escapers = new EscaperManager();
+        
+        // Verlet neighbor list shared by the near-field gravity sum and collision detection
+        this.useNeighborLists = true;
+        this.neighborList = new NeighborList();
+        
+        // Multiple time stepping (RESPA): near-field pairs are integrated every step while the
+        // tree far field is refreshed only every few steps and applied as an outer kick
+        this.multipleTimeStepping = false;
+        this.farFieldInterval = PHYSICS_CONSTANTS.FAR_FIELD_INTERVAL; // Configured steps per far-field evaluation
+        this.autoTuneFarFieldInterval = true; // Let the far-field change monitor adjust the interval
+        this.multipleTimeStep = {
+            interval: this.farFieldInterval, // Interval in use (the tuned value)
+            cycleLength: 0, // Interval of the cycle in progress
+            phase: 0, // Inner steps taken in the current cycle
+            bodyRefs: [], // Bodies the cached accelerations belong to
+            farX: new Float64Array(0), farY: new Float64Array(0),
+            previousFarX: new Float64Array(0), previousFarY: new Float64Array(0),
+            nearX: new Float64Array(0), nearY: new Float64Array(0),
+            farValid: false, // farX/farY hold the far field at the current positions
+            nearValid: false, // nearX/nearY hold the near field at the current positions
+            cycleTimeStep: 0, // Step size held for the whole cycle in progress
+            cycleElapsed: 0, // Time the cycle in progress has covered
+            openingKick: 0, // Far kick time given when the cycle opened
+            farChange: 0, // RMS relative change of the far field over the last cycle
+            farEvaluations: 0,
+            steps: 0
+        };
+        
+        // Sequential-impulse contact solver and sleeping islands for elastic collisions
+        this.contactSolver = new ContactSolver();
+        this.sleepManager = new SleepManager();
+        
+        // Multi-level grid broadphase for collisions when neighbor lists are off
+        this.collisionGrid = new MultiLevelGrid();
+        this.collisionGridX = new Float64Array(0);
+        this.collisionGridY = new Float64Array(0);
+        this.collisionGridRadius = new Float64Array(0);
+        
         // GPU Physics Engine
         this.gpuPhysics = null;
         this.useGPUPhysics = false;
@@ -53,7 +113,9 @@ class PhysicsEngine {
     // Utility function to validate and sanitize numerical values
     validateNumber(value, fallback = 0, name = 'unknown') {
         if (isNaN(value) || !isFinite(value)) {
-            console.warn(`Physics: Invalid number detected for ${name}: ${value}, using fallback: ${fallback}`);
+            if (Diagnostics.counts[DIAGNOSTIC.PHYSICS_INVALID_NUMBER]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.PHYSICS_INVALID_NUMBER, `${name} was ${value}, replaced by ${fallback}`);
+            }
             return fallback;
         }
         return value;
@@ -71,7 +133,9 @@ class PhysicsEngine {
         
         // Ensure mass is always positive
         if (body.mass <= 0) {
-            console.warn(`Physics: Non-positive mass detected for body ${body.id}: ${body.mass}, setting to 1`);
+            if (Diagnostics.counts[DIAGNOSTIC.PHYSICS_NON_POSITIVE_MASS]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.PHYSICS_NON_POSITIVE_MASS, `body ${body.id} mass ${body.mass}, set to 1`);
+            }
             body.mass = 1;
         }
     }
@@ -104,6 +168,12 @@ class PhysicsEngine {
         
         this.timeAccumulator += deltaTime * this.timeScale;
         
+        const frameTimings = this.frameTimings;
+        frameTimings.steps = 0;
+        frameTimings.treeBuild = 0;
+        frameTimings.treeWalk = 0;
+        frameTimings.collisions = 0;
+        
         this.totalKineticEnergy = 0;
         this.totalPotentialEnergy = 0;
         
@@ -112,14 +182,21 @@ class PhysicsEngine {
         if (this.adaptiveTimeStep && bodies.length > 0) {
             currentTimeStep = this.calculateAdaptiveTimeStep(bodies);
         }
+        // A multiple-time-stepping cycle keeps one step size, so its two far kicks are equal
+        // and add up to the time it covers
+        if (this.multipleTimeStep.phase > 0 && this.usesMultipleTimeStepping(bodies.length)) {
+            currentTimeStep = this.multipleTimeStep.cycleTimeStep;
+        }
         
         // Run physics in timesteps while we have accumulated enough time
+        const frameStartTime = this.simulationTime;
         let totalForceTime = 0;
         let totalIntegrationTime = 0;
         let stepsExecuted = 0;
         
         while (this.timeAccumulator >= currentTimeStep) {
             const forceStart = performance.now();
+            this.costProfile.begin(bodies.length);
             
             // Check if we should use GPU physics for this frame
             if (this.shouldUseGPUPhysics(bodies.length)) {
@@ -134,8 +211,10 @@ class PhysicsEngine {
                         this.calculateForcesNaive(bodies);
                     }
                 }
-            } else {
-                // Use CPU physics
+            } else if (this.usesMultipleTimeStepping(bodies.length)) {
+                // Forces are evaluated inside the step itself
+            } else if (this.integrationMethod !== 'rk4') {
+                // Use CPU physics (RK4 evaluates forces at its own first stage, so a pass here would be discarded)
                 if (this.forceCalculationMethod === 'barnes-hut' && bodies.length > PHYSICS_CONSTANTS.BARNES_HUT_MAX_BODIES_THRESHOLD) {
                     this.calculateForcesBarnesHut(bodies);
                 } else {
@@ -149,7 +228,9 @@ class PhysicsEngine {
             
             // Only do CPU integration if not using GPU physics
             if (!this.shouldUseGPUPhysics(bodies.length)) {
-                if (this.integrationMethod === 'rk4') {
+                if (this.usesMultipleTimeStepping(bodies.length)) {
+                    this.stepMultipleTimeStepping(bodies, currentTimeStep);
+                } else if (this.integrationMethod === 'rk4') {
                     this.integrator.integrateRK4(bodies, currentTimeStep, (bodies) => {
                         if (this.forceCalculationMethod === 'barnes-hut' && bodies.length > 5) {
                             this.calculateForcesBarnesHut(bodies);
@@ -164,23 +245,32 @@ class PhysicsEngine {
             
             totalIntegrationTime += performance.now() - integrationStart;
             
+            // Sleeping islands only exist while elastic collisions are active
+            const elasticCollisions = this.collisionEnabled &&
+                this.collisionType === PHYSICS_CONSTANTS.COLLISION_TYPE.ELASTIC;
+            if (elasticCollisions) {
+                this.sleepManager.constrainSleepingIslands(bodies);
+            } else if (this.sleepManager.sleepingCount > 0) {
+                this.sleepManager.wakeAll(bodies);
+            }
+            
             // Handle collisions
             if (this.collisionEnabled) {
-                this.handleCollisions(bodies);
+                const collisionStart = performance.now();
+                this.handleCollisions(bodies, currentTimeStep);
+                frameTimings.collisions += performance.now() - collisionStart;
             }
             
-            // Update collision cooldowns for all bodies
-            bodies.forEach(body => {
-                if (body.updateCollisionCooldowns) {
-                    body.updateCollisionCooldowns(currentTimeStep);
-                }
-            });
+            if (elasticCollisions && this.sleepManager.enabled) {
+                this.sleepManager.update(bodies, currentTimeStep);
+            }
             
             // Subtract the timestep from accumulator
             this.timeAccumulator -= currentTimeStep;
             this.simulationTime += currentTimeStep;
             stepsExecuted++;
         }
+        frameTimings.steps = stepsExecuted;
         
         // Update timing statistics (average if multiple steps were executed)
         if (stepsExecuted > 0) {
@@ -193,17 +283,43 @@ class PhysicsEngine {
             this.integrationTime = Math.max(0, this.integrationTime * 0.9);
         }
         
+        // Archive escapers before the energy pass, so totals describe the active set
+        if (stepsExecuted > 0) {
+            this.finishFrame(bodies, this.simulationTime - frameStartTime);
+            this.updateEscapers(bodies);
+        }
+        
         // Calculate total energy
         this.calculateTotalEnergy(bodies);
         
-        // Update energy history
-        this.updateEnergyHistory();
+        // Update energy history (its first entry is the drift baseline, so not before the
+        // scene's potential energy is known)
+        if (this.potentialEnergyKnown) {
+            this.updateEnergyHistory();
+        }
         
         this.physicsTime = performance.now() - startTime;
         
         return bodies;
     }
 
+    // Per-body bookkeeping (trails, visuals) once for the whole frame rather
+    // than in every step
+    finishFrame(bodies, frameTime) {
+        for (let i = 0; i < bodies.length; i++) {
+            bodies[i].finishFrame(frameTime, this.simulationTime, this.sampleTrails);
+        }
+    }
+
+    // Archive unbound bodies beyond the escape radius and advance archived ones to the
+    // current simulation time. Also called by the app after worker steps, since the
+    // archive lives on the main thread.
+    updateEscapers(bodies) {
+        // A two-body path is meaningless inside an external field, so nothing is archived then
+        this.escapers.update(bodies, this.simulationTime, this.gravitationalConstant, !this.forceFields.hasFields());
+        this.currentBodyCount = bodies.length;
+    }
+
     // Calculate gravitational forces between all bodies
     calculateForces(bodies) {
         // Reset forces
@@ -213,33 +329,78 @@ class PhysicsEngine {
         this.calculateForcesNaive(bodies);
     }
 
+    // Direct O(n²) sum over packed copies of the bodies, using a kernel specialized for the
+    // current settings (see ForceKernelGenerator) or the generic loop when that is unavailable
     calculateForcesNaive(bodies) {
-        for (let i = 0; i < bodies.length; i++) {
-            for (let j = i + 1; j < bodies.length; j++) {
-                const body1 = bodies[i];
-                const body2 = bodies[j];
-                
-                const force = body1.calculateGravitationalForce(
-                    body2, 
-                    this.gravitationalConstant, 
-                    this.softeningParameter
-                );
-                
-                body1.applyForce(force);
-                body2.applyForce(force.multiply(-1)); // Newton's third law
-                
-                // Calculate potential energy for this pair (use same softening as force)
-                const dx = body1.position.x - body2.position.x;
-                const dy = body1.position.y - body2.position.y;
-                const distanceSquared = dx * dx + dy * dy;
-                const softenedDistanceSquared = distanceSquared + this.softeningParameter * this.softeningParameter;
-                const distance = Math.sqrt(softenedDistanceSquared);
-                const potentialEnergy = -this.gravitationalConstant * body1.mass * body2.mass / distance;
-                
-                body1.potentialEnergy += potentialEnergy / 2;
-                body2.potentialEnergy += potentialEnergy / 2;
-            }
+        const n = bodies.length;
+        const buffers = this.getKernelBuffers(n);
+        let hasFixed = false;
+        
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            buffers.x[i] = body.position.x;
+            buffers.y[i] = body.position.y;
+            buffers.vx[i] = body.velocity.x;
+            buffers.vy[i] = body.velocity.y;
+            buffers.m[i] = body.mass;
+            buffers.fixed[i] = body.fixed ? 1 : 0;
+            if (body.fixed) hasFixed = true;
+        }
+        
+        const options = this.kernelOptions;
+        options.gravitationalConstant = this.gravitationalConstant;
+        options.softeningParameter = this.softeningParameter;
+        options.hasFixed = hasFixed;
+        options.trackPotential = this.trackBodyPotentialEnergy;
+        options.fields = this.forceFields.specs;
+        const kernel = this.useSpecializedKernels ? this.kernelGenerator.getDirectKernel(options) : null;
+        
+        if (this.costProfile.enabled) {
+            const direct = this.costProfile.directInteractions;
+            for (let i = 0; i < n; i++) direct[i] += n - 1;
+        }
+        
+        if (kernel) {
+            kernel(buffers.x, buffers.y, buffers.vx, buffers.vy, buffers.m, buffers.fixed,
+                buffers.fx, buffers.fy, buffers.pe, n,
+                this.gravitationalConstant, this.softeningParameter * this.softeningParameter);
+        } else {
+            genericDirectKernel(buffers.x, buffers.y, buffers.vx, buffers.vy, buffers.m, buffers.fixed,
+                buffers.fx, buffers.fy, buffers.pe, n, options);
+        }
+        
+        // The pass replaces whatever force a body carried in (e.g. the initial force
+        // insertBodies gives new bodies for the adaptive step estimate)
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            body.force.x = buffers.fx[i];
+            body.force.y = buffers.fy[i];
+            if (this.trackBodyPotentialEnergy) body.potentialEnergy = buffers.pe[i];
+        }
+        
+        // Specialized kernels include the field terms
+        if (!kernel) {
+            this.forceFields.applyToBodies(bodies, this.gravitationalConstant);
+        }
+    }
+
+    // Packed scratch arrays for the direct-sum kernels, grown as needed
+    getKernelBuffers(n) {
+        if (!this.kernelBuffers || this.kernelBuffers.x.length < n) {
+            const capacity = Math.max(n, 64, this.kernelBuffers ? this.kernelBuffers.x.length * 2 : 0);
+            this.kernelBuffers = {
+                x: new Float64Array(capacity),
+                y: new Float64Array(capacity),
+                vx: new Float64Array(capacity),
+                vy: new Float64Array(capacity),
+                m: new Float64Array(capacity),
+                fixed: new Uint8Array(capacity),
+                fx: new Float64Array(capacity),
+                fy: new Float64Array(capacity),
+                pe: new Float64Array(capacity)
+            };
         }
+        return this.kernelBuffers;
     }
 
     // Enhanced Barnes-Hut O(N log N) force calculation with optimized memory layout
@@ -252,19 +413,358 @@ class PhysicsEngine {
             body.potentialEnergy = 0;
         });
         
-        // Use optimized Barnes-Hut calculator
+        // Use optimized Barnes-Hut calculator for the far field
+        const nearFieldRadius = this.getNearFieldRadius(bodies.length);
         this.optimizedBarnesHut.setTheta(this.barnesHutTheta);
-        const forces = this.optimizedBarnesHut.calculateForces(bodies, this.gravitationalConstant, this.softeningParameter);
+        const forces = this.optimizedBarnesHut.calculateForces(bodies, this.gravitationalConstant, this.softeningParameter, nearFieldRadius);
         
-        // Apply calculated forces
+        // Apply calculated forces (the tree returns per-unit-mass accelerations), with any
+        // external fields added in the same pass
+        const fields = this.forceFields.hasFields() ? this.forceFields : null;
         for (let i = 0; i < bodies.length; i++) {
-            bodies[i].force.x += forces[i].x;
-            bodies[i].force.y += forces[i].y;
+            bodies[i].force.x += forces[i].x * bodies[i].mass;
+            bodies[i].force.y += forces[i].y * bodies[i].mass;
+            if (fields && !bodies[i].fixed) {
+                fields.accumulate(bodies[i], this.gravitationalConstant);
+            }
+        }
+        
+        // Close pairs the tree skipped are summed exactly from the neighbor list
+        if (nearFieldRadius > 0) {
+            this.calculateNearFieldForces(bodies, nearFieldRadius);
         }
         
         // Track performance statistics
         this.forceCalculationTime = performance.now() - startTime;
         this.barnesHutStats = this.optimizedBarnesHut.getStats();
+        this.addTreeTimings();
+    }
+
+    addTreeTimings() {
+        const stats = this.optimizedBarnesHut.stats;
+        this.frameTimings.treeBuild += stats.treeConstructionTime;
+        this.frameTimings.treeWalk += stats.forceCalculationTime;
+    }
+    
+    // Radius of the direct near-field sum; zero whenever the tree is not in use
+    getNearFieldRadius(bodyCount) {
+        if (!this.useNeighborLists ||
+            this.forceCalculationMethod !== 'barnes-hut' ||
+            bodyCount <= PHYSICS_CONSTANTS.BARNES_HUT_MAX_BODIES_THRESHOLD ||
+            this.shouldUseGPUPhysics(bodyCount)) {
+            return 0;
+        }
+        // Multiple time stepping widens the near field so it carries the fast-changing pairs
+        const ratio = this.multipleTimeStepping && this.integrationMethod !== 'rk4' ?
+            PHYSICS_CONSTANTS.MULTIPLE_TIME_STEP_NEAR_RATIO : PHYSICS_CONSTANTS.NEAR_FIELD_SOFTENING_RATIO;
+        return this.softeningParameter * ratio;
+    }
+
+    // Multiple time stepping needs the tree/neighbor-list split and a kick-drift integrator
+    usesMultipleTimeStepping(bodyCount) {
+        return this.multipleTimeStepping && this.integrationMethod !== 'rk4' &&
+            this.getNearFieldRadius(bodyCount) > 0;
+    }
+
+    // Refresh the shared neighbor list for the current positions (rebuilds only when stale).
+    // Contact ranges are swept over the step being taken; gravity passes keep whatever
+    // sweep the list already has.
+    updateNeighborList(bodies, sweepTime = this.neighborList.sweepTime) {
+        this.neighborList.update(bodies, this.getNearFieldRadius(bodies.length), sweepTime);
+        return this.neighborList;
+    }
+
+    // Direct gravity between pairs closer than the near-field radius
+    calculateNearFieldForces(bodies, nearFieldRadius) {
+        const list = this.updateNeighborList(bodies);
+        const G = this.gravitationalConstant;
+        const softeningSquared = this.softeningParameter * this.softeningParameter;
+        const radiusSquared = nearFieldRadius * nearFieldRadius;
+        
+        for (let p = 0; p < list.pairCount; p++) {
+            const body1 = bodies[list.pairA[p]];
+            const body2 = bodies[list.pairB[p]];
+            
+            const dx = body2.position.x - body1.position.x;
+            const dy = body2.position.y - body1.position.y;
+            const distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared >= radiusSquared) continue;
+            
+            const invDistance = 1 / Math.sqrt(distanceSquared + softeningSquared);
+            const strength = G * body1.mass * body2.mass * invDistance * invDistance * invDistance;
+            
+            body1.force.x += dx * strength;
+            body1.force.y += dy * strength;
+            body2.force.x -= dx * strength;
+            body2.force.y -= dy * strength;
+        }
+        
+        if (this.costProfile.enabled) {
+            this.costProfile.addPairs(this.costProfile.directInteractions, list.pairA, list.pairB, list.pairCount);
+        }
+    }
+    
+    // One step of impulse multiple time stepping (RESPA). Each cycle of K steps is
+    //   half kick with the far field, K velocity Verlet steps with the near field,
+    //   half kick with the far field at the new positions,
+    // so the tree runs once per cycle; the closing far field also opens the next cycle.
+    // Velocities are synchronized at cycle boundaries.
+    stepMultipleTimeStepping(bodies, deltaTime) {
+        const state = this.multipleTimeStep;
+        const nearFieldRadius = this.getNearFieldRadius(bodies.length);
+        this.syncMultipleTimeStepBodies(bodies);
+        
+        if (state.phase === 0) {
+            if (!state.farValid) {
+                this.calculateFarFieldAccelerations(bodies, nearFieldRadius);
+            }
+            state.cycleLength = state.interval;
+            state.cycleTimeStep = deltaTime;
+            state.cycleElapsed = 0;
+            state.openingKick = 0.5 * state.cycleLength * deltaTime;
+            this.applyFarFieldKick(bodies, state.openingKick);
+        }
+        
+        // Inner kick-drift-kick with the near field
+        if (!state.nearValid) {
+            this.calculateNearFieldAccelerations(bodies, nearFieldRadius);
+        }
+        const halfStep = 0.5 * deltaTime;
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body.fixed) continue;
+            
+            body.velocity.x += state.nearX[i] * halfStep;
+            body.velocity.y += state.nearY[i] * halfStep;
+            if (body.lastPosition) {
+                body.lastPosition.set(body.position.x, body.position.y);
+            } else {
+                body.lastPosition = body.position.clone();
+            }
+            body.position.x += body.velocity.x * deltaTime;
+            body.position.y += body.velocity.y * deltaTime;
+        }
+        state.farValid = false;
+        
+        this.calculateNearFieldAccelerations(bodies, nearFieldRadius);
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body.fixed) continue;
+            body.velocity.x += state.nearX[i] * halfStep;
+            body.velocity.y += state.nearY[i] * halfStep;
+        }
+        
+        state.phase++;
+        state.steps++;
+        state.cycleElapsed += deltaTime;
+        if (state.phase >= state.cycleLength) {
+            // The far impulses of a cycle must total the time it covered
+            this.calculateFarFieldAccelerations(bodies, nearFieldRadius);
+            this.applyFarFieldKick(bodies, state.cycleElapsed - state.openingKick);
+            state.phase = 0;
+            if (this.autoTuneFarFieldInterval) {
+                this.tuneFarFieldInterval();
+            }
+        }
+    }
+
+    // Positions changed outside the integrator (contact position pass, drags, worker
+    // sync): the cached accelerations no longer match them
+    invalidateCachedAccelerations() {
+        this.multipleTimeStep.nearValid = false;
+        this.multipleTimeStep.farValid = false;
+    }
+
+    // Cached accelerations are indexed like the bodies array; any change to the body set
+    // (merges, additions, removals) drops them. A cycle cut short this way loses its
+    // closing kick, an error of one half kick of a slowly changing field.
+    syncMultipleTimeStepBodies(bodies) {
+        const state = this.multipleTimeStep;
+        const n = bodies.length;
+        let same = state.bodyRefs.length === n;
+        for (let i = 0; same && i < n; i++) {
+            same = state.bodyRefs[i] === bodies[i];
+        }
+        if (same) return;
+        
+        state.bodyRefs = bodies.slice();
+        if (state.farX.length !== n) {
+            state.farX = new Float64Array(n);
+            state.farY = new Float64Array(n);
+            state.previousFarX = new Float64Array(n);
+            state.previousFarY = new Float64Array(n);
+            state.nearX = new Float64Array(n);
+            state.nearY = new Float64Array(n);
+        }
+        state.farValid = false;
+        state.nearValid = false;
+        state.phase = 0;
+    }
+
+    // Weight of a pair in the near field: 1 inside the switching shell, easing smoothly
+    // (smoothstep) to 0 at the near-field radius, so both parts of the split stay smooth
+    // as pairs cross between them
+    nearFieldWeight(distance, nearFieldRadius) {
+        const inner = nearFieldRadius * (1 - PHYSICS_CONSTANTS.MULTIPLE_TIME_STEP_SWITCH_WIDTH);
+        if (distance <= inner) return 1;
+        if (distance >= nearFieldRadius) return 0;
+        const t = (distance - inner) / (nearFieldRadius - inner);
+        return 1 - t * t * (3 - 2 * t);
+    }
+
+    // Far-field accelerations: the tree without pairs inside the near-field radius, plus
+    // the switched-off share of the pairs inside it. Records how much the field changed
+    // since the previous evaluation for the interval tuner.
+    calculateFarFieldAccelerations(bodies, nearFieldRadius) {
+        const state = this.multipleTimeStep;
+        const n = bodies.length;
+        const G = this.gravitationalConstant;
+        const softeningSquared = this.softeningParameter * this.softeningParameter;
+        const hadPrevious = state.farEvaluations > 0 && state.phase > 0;
+        
+        // The previous field moves to the spare buffers
+        let swap = state.previousFarX;
+        state.previousFarX = state.farX;
+        state.farX = swap;
+        swap = state.previousFarY;
+        state.previousFarY = state.farY;
+        state.farY = swap;
+        
+        this.optimizedBarnesHut.setTheta(this.barnesHutTheta);
+        const forces = this.optimizedBarnesHut.calculateForces(bodies, G, this.softeningParameter, nearFieldRadius);
+        const farX = state.farX;
+        const farY = state.farY;
+        for (let i = 0; i < n; i++) {
+            farX[i] = forces[i].x;
+            farY[i] = forces[i].y;
+        }
+        this.barnesHutStats = this.optimizedBarnesHut.getStats();
+        this.addTreeTimings();
+        
+        const list = this.updateNeighborList(bodies);
+        const radiusSquared = nearFieldRadius * nearFieldRadius;
+        for (let p = 0; p < list.pairCount; p++) {
+            const a = list.pairA[p];
+            const b = list.pairB[p];
+            const dx = bodies[b].position.x - bodies[a].position.x;
+            const dy = bodies[b].position.y - bodies[a].position.y;
+            const distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared >= radiusSquared) continue;
+            
+            const share = 1 - this.nearFieldWeight(Math.sqrt(distanceSquared), nearFieldRadius);
+            if (share <= 0) continue;
+            const invDistance = 1 / Math.sqrt(distanceSquared + softeningSquared);
+            const strength = share * G * invDistance * invDistance * invDistance;
+            farX[a] += dx * strength * bodies[b].mass;
+            farY[a] += dy * strength * bodies[b].mass;
+            farX[b] -= dx * strength * bodies[a].mass;
+            farY[b] -= dy * strength * bodies[a].mass;
+        }
+        
+        if (this.costProfile.enabled) {
+            this.costProfile.addPairs(this.costProfile.directInteractions, list.pairA, list.pairB, list.pairCount);
+        }
+        
+        if (hadPrevious) {
+            let changeSquared = 0;
+            let fieldSquared = 0;
+            for (let i = 0; i < n; i++) {
+                const ddx = farX[i] - state.previousFarX[i];
+                const ddy = farY[i] - state.previousFarY[i];
+                changeSquared += ddx * ddx + ddy * ddy;
+                fieldSquared += state.previousFarX[i] * state.previousFarX[i] + state.previousFarY[i] * state.previousFarY[i];
+            }
+            state.farChange = fieldSquared > 0 ? Math.sqrt(changeSquared / fieldSquared) : 0;
+        }
+        
+        state.farValid = true;
+        state.farEvaluations++;
+    }
+
+    // Near-field accelerations (switched pairs plus external fields) into nearX/nearY
+    calculateNearFieldAccelerations(bodies, nearFieldRadius) {
+        const state = this.multipleTimeStep;
+        const n = bodies.length;
+        const G = this.gravitationalConstant;
+        const softeningSquared = this.softeningParameter * this.softeningParameter;
+        const nearX = state.nearX;
+        const nearY = state.nearY;
+        
+        // Fields are accumulated through the body force, as in the single-rate path
+        const fields = this.forceFields.hasFields() ? this.forceFields : null;
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            nearX[i] = 0;
+            nearY[i] = 0;
+            if (fields && !body.fixed) {
+                body.resetForce();
+                fields.accumulate(body, G);
+                nearX[i] = body.force.x / body.mass;
+                nearY[i] = body.force.y / body.mass;
+                body.resetForce();
+            }
+        }
+        
+        const list = this.updateNeighborList(bodies);
+        const radiusSquared = nearFieldRadius * nearFieldRadius;
+        for (let p = 0; p < list.pairCount; p++) {
+            const a = list.pairA[p];
+            const b = list.pairB[p];
+            const dx = bodies[b].position.x - bodies[a].position.x;
+            const dy = bodies[b].position.y - bodies[a].position.y;
+            const distanceSquared = dx * dx + dy * dy;
+            if (distanceSquared >= radiusSquared) continue;
+            
+            const share = this.nearFieldWeight(Math.sqrt(distanceSquared), nearFieldRadius);
+            if (share <= 0) continue;
+            const invDistance = 1 / Math.sqrt(distanceSquared + softeningSquared);
+            const strength = share * G * invDistance * invDistance * invDistance;
+            nearX[a] += dx * strength * bodies[b].mass;
+            nearY[a] += dy * strength * bodies[b].mass;
+            nearX[b] -= dx * strength * bodies[a].mass;
+            nearY[b] -= dy * strength * bodies[a].mass;
+        }
+        
+        if (this.costProfile.enabled) {
+            this.costProfile.addPairs(this.costProfile.directInteractions, list.pairA, list.pairB, list.pairCount);
+        }
+        
+        state.nearValid = true;
+    }
+
+    applyFarFieldKick(bodies, kickTime) {
+        const state = this.multipleTimeStep;
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body.fixed) continue;
+            body.velocity.x += state.farX[i] * kickTime;
+            body.velocity.y += state.farY[i] * kickTime;
+        }
+    }
+
+    // Holding the far field for a cycle is only as good as the field is steady: halve the
+    // interval when it changed by more than the tolerance over the last cycle, and
+    // lengthen it by one when it changed by less than a quarter of that
+    tuneFarFieldInterval() {
+        const state = this.multipleTimeStep;
+        const tolerance = PHYSICS_CONSTANTS.FAR_FIELD_TOLERANCE;
+        if (state.farChange > tolerance) {
+            state.interval = Math.max(1, Math.floor(state.interval / 2));
+        } else if (state.farChange < tolerance / 4) {
+            state.interval = Math.min(PHYSICS_CONSTANTS.FAR_FIELD_MAX_INTERVAL, state.interval + 1);
+        }
+    }
+
+    getMultipleTimeSteppingStats() {
+        const state = this.multipleTimeStep;
+        return {
+            enabled: this.multipleTimeStepping,
+            active: this.usesMultipleTimeStepping(this.currentBodyCount),
+            interval: state.interval,
+            farChange: state.farChange,
+            farEvaluations: state.farEvaluations,
+            steps: state.steps
+        };
     }
     
     // Calculate bounding box for all bodies
@@ -299,10 +799,27 @@ class PhysicsEngine {
     calculateAdaptiveTimeStep(bodies) {
         let maxAcceleration = 0;
         
-        bodies.forEach(body => {
-            const acceleration = body.force.magnitude() / body.mass;
-            maxAcceleration = Math.max(maxAcceleration, acceleration);
-        });
+        // Multiple time stepping keeps its accelerations in its own buffers, not body.force
+        const state = this.multipleTimeStep;
+        let useCached = this.usesMultipleTimeStepping(bodies.length) && state.farEvaluations > 0 &&
+            state.bodyRefs.length === bodies.length;
+        for (let i = 0; useCached && i < bodies.length; i++) {
+            if (state.bodyRefs[i] !== bodies[i]) {
+                useCached = false;
+                break;
+            }
+            const ax = state.nearX[i] + state.farX[i];
+            const ay = state.nearY[i] + state.farY[i];
+            maxAcceleration = Math.max(maxAcceleration, Math.sqrt(ax * ax + ay * ay));
+        }
+        
+        if (!useCached) {
+            maxAcceleration = 0;
+            bodies.forEach(body => {
+                const acceleration = body.force.magnitude() / body.mass;
+                maxAcceleration = Math.max(maxAcceleration, acceleration);
+            });
+        }
         
         if (maxAcceleration === 0) {
             return this.fixedTimeStep;
@@ -323,19 +840,17 @@ class PhysicsEngine {
             } else {
                 body.updateEuler(deltaTime);
             }
-            
-            this.totalKineticEnergy += body.kineticEnergy;
         });
     }
 
     // Handle collisions between bodies (optimized)
-    handleCollisions(bodies) {
+    handleCollisions(bodies, timeStep) {
         if (this.collisionType === PHYSICS_CONSTANTS.COLLISION_TYPE.ELASTIC) {
-            this.handleElasticCollisions(bodies);
+            this.handleElasticCollisions(bodies, timeStep);
             // Apply velocity limiting after elastic collisions to prevent explosive behavior
             this.limitVelocities(bodies);
         } else {
-            this.handleInelasticCollisions(bodies);
+            this.handleInelasticCollisions(bodies, timeStep);
         }
     }
 
@@ -353,288 +868,127 @@ class PhysicsEngine {
         });
     }
 
-    // Enhanced elastic collision system inspired by broccoli-project
-    handleElasticCollisions(bodies) {
-        // Use spatial partitioning for better collision detection performance
-        const spatialGrid = this.createSpatialGrid(bodies);
-        const processedPairs = new Set();
-        
-        // Process collisions using spatial grid for efficiency
-        spatialGrid.forEach(cellBodies => {
-            if (cellBodies.length < 2) return;
-            
-            // Check all pairs within this spatial cell
-            for (let i = 0; i < cellBodies.length; i++) {
-                for (let j = i + 1; j < cellBodies.length; j++) {
-                    const body1 = cellBodies[i];
-                    const body2 = cellBodies[j];
-                    
-                    // Create unique pair identifier
-                    const id1 = bodies.indexOf(body1);
-                    const id2 = bodies.indexOf(body2);
-                    const pairKey = `${Math.min(id1, id2)}-${Math.max(id1, id2)}`;
-                    
-                    if (processedPairs.has(pairKey)) continue;
-                    processedPairs.add(pairKey);
-                    
-                    // Enhanced collision detection with continuous collision detection
-                    if (this.detectAndResolveCollision(body1, body2)) {
-                        // Apply collision cooldown to prevent jittering (time in seconds)
-                        const cooldownTime = PHYSICS_CONSTANTS.COLLISION_COOLDOWN_TIME || 0.25;
-                        body1.setCollisionCooldownWith(body2, cooldownTime);
-                        body2.setCollisionCooldownWith(body1, cooldownTime);
-                    }
-                }
+    // Elastic collisions after a step of timeStep: gather contacts from the broadphase,
+    // then solve them together
+    handleElasticCollisions(bodies, timeStep) {
+        this.sleepManager.beginStep();
+        this.contactSolver.restitution = this.restitutionCoefficient;
+        this.contactSolver.beginStep(timeStep);
+        
+        if (this.useNeighborLists) {
+            // Candidate pairs come from the shared neighbor list
+            const list = this.updateNeighborList(bodies, timeStep);
+            for (let p = 0; p < list.pairCount; p++) {
+                this.processElasticPair(bodies, list.pairA[p], list.pairB[p]);
             }
-        });
-    }
-
-    // Create spatial grid for efficient collision detection (inspired by broccoli's spatial partitioning)
-    createSpatialGrid(bodies) {
-        if (bodies.length === 0) return new Map();
-        
-        // Find simulation bounds
-        let minX = Infinity, maxX = -Infinity;
-        let minY = Infinity, maxY = -Infinity;
-        let maxRadius = 0;
-        
-        bodies.forEach(body => {
-            minX = Math.min(minX, body.position.x - body.radius);
-            maxX = Math.max(maxX, body.position.x + body.radius);
-            minY = Math.min(minY, body.position.y - body.radius);
-            maxY = Math.max(maxY, body.position.y + body.radius);
-            maxRadius = Math.max(maxRadius, body.radius);
-        });
-        
-        // Calculate optimal cell size (2x largest radius to handle overlaps)
-        const cellSize = Math.max(maxRadius * 4, 50);
-        const gridWidth = Math.ceil((maxX - minX) / cellSize);
-        const gridHeight = Math.ceil((maxY - minY) / cellSize);
-        
-        const spatialGrid = new Map();
-        
-        // Place bodies in grid cells
-        bodies.forEach(body => {
-            const cellX = Math.floor((body.position.x - minX) / cellSize);
-            const cellY = Math.floor((body.position.y - minY) / cellSize);
-            
-            // Add to multiple cells if body spans across cell boundaries
-            const startX = Math.max(0, Math.floor((body.position.x - body.radius - minX) / cellSize));
-            const endX = Math.min(gridWidth - 1, Math.floor((body.position.x + body.radius - minX) / cellSize));
-            const startY = Math.max(0, Math.floor((body.position.y - body.radius - minY) / cellSize));
-            const endY = Math.min(gridHeight - 1, Math.floor((body.position.y + body.radius - minY) / cellSize));
-            
-            for (let x = startX; x <= endX; x++) {
-                for (let y = startY; y <= endY; y++) {
-                    const cellKey = `${x},${y}`;
-                    if (!spatialGrid.has(cellKey)) {
-                        spatialGrid.set(cellKey, []);
-                    }
-                    spatialGrid.get(cellKey).push(body);
-                }
-            }
-        });
+        } else {
+            // Without neighbor lists, use the multi-level grid broadphase directly
+            this.buildCollisionGrid(bodies, timeStep).forEachCandidatePair((i, j) => this.processElasticPair(bodies, i, j));
+        }
         
-        return spatialGrid;
+        this.contactSolver.solve(bodies);
+        if (this.contactSolver.movedPositions) {
+            this.invalidateCachedAccelerations();
+        }
     }
 
-    // Enhanced collision detection and resolution
-    detectAndResolveCollision(body1, body2) {
-        // Skip if bodies are in cooldown with each other
-        if (body1.isInCollisionCooldownWith && body1.isInCollisionCooldownWith(body2)) {
-            return false;
-        }
-        
-        // Calculate separation vector
-        const dx = body2.position.x - body1.position.x;
-        const dy = body2.position.y - body1.position.y;
-        const distance = Math.sqrt(dx * dx + dy * dy);
-        const collisionDistance = body1.radius + body2.radius;
-        
-        // Calculate relative velocity for continuous collision detection
-        const relativeVx = body2.velocity.x - body1.velocity.x;
-        const relativeVy = body2.velocity.y - body1.velocity.y;
-        const relativeSpeed = Math.sqrt(relativeVx * relativeVx + relativeVy * relativeVy);
-        
-        // Debug logging for collision detection (reduced spam)
-        // Uncomment for debugging: if (distance < collisionDistance * 1.2 && relativeSpeed > 5) { console.log(`Near collision: distance=${distance.toFixed(2)}, required=${collisionDistance.toFixed(2)}, speed=${relativeSpeed.toFixed(2)}`); }
-        
-        // Continuous collision detection for fast-moving objects
-        let willCollide = false;
-        let collisionTime = 0;
-        
-        if (distance > collisionDistance && relativeSpeed > 0.1) {
-            // Simple continuous collision detection: check if bodies will pass through each other this frame
-            // Calculate where each body will be next frame
-            const dt = this.fixedTimeStep;
-            const body1NextX = body1.position.x + body1.velocity.x * dt;
-            const body1NextY = body1.position.y + body1.velocity.y * dt;
-            const body2NextX = body2.position.x + body2.velocity.x * dt;
-            const body2NextY = body2.position.y + body2.velocity.y * dt;
-            
-            const nextDx = body2NextX - body1NextX;
-            const nextDy = body2NextY - body1NextY;
-            const nextDistance = Math.sqrt(nextDx * nextDx + nextDy * nextDy);
-            
-            // If they will be overlapping next frame, collision is imminent
-            if (nextDistance <= collisionDistance) {
-                willCollide = true;
-            }
-            
-            // Also check if they're on a collision course (dot product approach)
-            const relativeVelDotPos = (relativeVx * dx + relativeVy * dy);
-            if (relativeVelDotPos < 0) { // Objects approaching
-                // Calculate closest approach distance during this frame
-                const closestDistance = Math.sqrt(distance * distance - (relativeVelDotPos * relativeVelDotPos) / (relativeSpeed * relativeSpeed));
-                if (closestDistance <= collisionDistance) {
-                    willCollide = true;
-                }
-            }
+    // Narrowphase for one candidate pair in elastic mode
+    processElasticPair(bodies, i, j) {
+        const body1 = bodies[i];
+        const body2 = bodies[j];
+        const sleepManager = this.sleepManager;
+        
+        if (this.costProfile.enabled) {
+            this.costProfile.collisionCandidates[i]++;
+            this.costProfile.collisionCandidates[j]++;
         }
         
-        // Check for collision
-        if (distance <= collisionDistance || willCollide) {
-            this.resolveElasticCollision(body1, body2, dx, dy, distance, collisionDistance);
-            return true;
+        // Nothing changes inside a sleeping island
+        if (sleepManager.canSkipPair(body1, body2)) return;
+        
+        if (this.contactSolver.addCandidate(i, j, body1, body2) && (body1.sleeping || body2.sleeping)) {
+            // A real hit wakes whatever island it touched; gentle contacts let it sleep on
+            const relativeVx = body2.velocity.x - body1.velocity.x;
+            const relativeVy = body2.velocity.y - body1.velocity.y;
+            const threshold = sleepManager.velocityThreshold;
+            if (relativeVx * relativeVx + relativeVy * relativeVy > threshold * threshold) {
+                if (body1.sleeping) sleepManager.wakeIsland(body1.sleepIsland);
+                if (body2.sleeping) sleepManager.wakeIsland(body2.sleepIsland);
+            }
         }
         
-        return false;
+        sleepManager.recordContact(i, j, body1, body2);
     }
 
-    // Advanced elastic collision resolution with proper physics
-    resolveElasticCollision(body1, body2, dx, dy, distance, collisionDistance) {
-        // Calculate collision normal
-        const normalX = distance > 0.001 ? dx / distance : 1;
-        const normalY = distance > 0.001 ? dy / distance : 0;
-        
-        // Handle penetration with MORE aggressive separation
-        const overlap = collisionDistance - distance;
-        if (overlap > 0 || distance < collisionDistance * 1.2) {
-            // More aggressive separation - ensure bodies are definitely apart
-            const separationFactor = 2.0; // Much larger separation to prevent re-collision
-            const minSeparation = collisionDistance * 0.1; // Minimum separation distance
-            const totalSeparation = Math.max(overlap * separationFactor, minSeparation);
-            const totalMass = body1.mass + body2.mass;
-            
-            // Mass-proportional separation (lighter objects move more)
-            const separation1 = totalSeparation * body2.mass / totalMass;
-            const separation2 = totalSeparation * body1.mass / totalMass;
-            
-            body1.position.x -= separation1 * normalX;
-            body1.position.y -= separation1 * normalY;
-            body2.position.x += separation2 * normalX;
-            body2.position.y += separation2 * normalY;
-            
-            // Update Verlet integration positions for consistency
-            if (body1.lastPosition) {
-                body1.lastPosition.x -= separation1 * normalX;
-                body1.lastPosition.y -= separation1 * normalY;
-            }
-            if (body2.lastPosition) {
-                body2.lastPosition.x += separation2 * normalX;
-                body2.lastPosition.y += separation2 * normalY;
-            }
-            
-            // Uncomment for debugging: console.log(`Separated bodies: overlap=${overlap.toFixed(2)}, separation=${totalSeparation.toFixed(2)}, new distance=${Math.sqrt((body2.position.x - body1.position.x)**2 + (body2.position.y - body1.position.y)**2).toFixed(2)}`);
+    // Place bodies in the multi-level grid by their radius swept over one step.
+    // Each body sits at the level matching its size, so a single star does not
+    // inflate the cells used by small debris.
+    buildCollisionGrid(bodies, timeStep) {
+        const n = bodies.length;
+        
+        if (this.collisionGridX.length < n) {
+            const capacity = Math.max(n, this.collisionGridX.length * 2, 16);
+            this.collisionGridX = new Float64Array(capacity);
+            this.collisionGridY = new Float64Array(capacity);
+            this.collisionGridRadius = new Float64Array(capacity);
         }
         
-        // Calculate relative velocity along collision normal
-        const relativeVx = body2.velocity.x - body1.velocity.x;
-        const relativeVy = body2.velocity.y - body1.velocity.y;
-        const relativeVelNormal = relativeVx * normalX + relativeVy * normalY;
-        
-        // Don't resolve if objects are separating
-        if (relativeVelNormal > 0) return;
-        
-        // Calculate collision impulse (inspired by broccoli's physics)
-        const e = this.restitutionCoefficient;
-        const impulseStrength = -(1 + e) * relativeVelNormal / (1/body1.mass + 1/body2.mass);
-        
-        // Apply impulse to velocities
-        const impulseX = impulseStrength * normalX;
-        const impulseY = impulseStrength * normalY;
-        
-        body1.velocity.x -= impulseX / body1.mass;
-        body1.velocity.y -= impulseY / body1.mass;
-        body2.velocity.x += impulseX / body2.mass;
-        body2.velocity.y += impulseY / body2.mass;
-        
-        // Add tangential friction for realistic behavior
-        const friction = PHYSICS_CONSTANTS.COLLISION_FRICTION || 0.1;
-        if (friction > 0) {
-            // Calculate tangential component of relative velocity
-            const tangentX = relativeVx - relativeVelNormal * normalX;
-            const tangentY = relativeVy - relativeVelNormal * normalY;
-            const tangentMagnitude = Math.sqrt(tangentX * tangentX + tangentY * tangentY);
-            
-            if (tangentMagnitude > 0.001) {
-                const frictionImpulse = Math.min(friction * Math.abs(impulseStrength), tangentMagnitude);
-                // Friction opposes relative tangential motion
-                // tangent is (body2 - body1), so to reduce relative motion:
-                // body1 gets pushed in +tangent direction, body2 in -tangent direction
-                const frictionX = frictionImpulse * tangentX / tangentMagnitude;
-                const frictionY = frictionImpulse * tangentY / tangentMagnitude;
-                
-                // Apply friction impulse (divide by mass for velocity change)
-                const friction1 = 1 / (body1.mass + body2.mass) * body2.mass;
-                const friction2 = 1 / (body1.mass + body2.mass) * body1.mass;
-                body1.velocity.x += frictionX * friction1;
-                body1.velocity.y += frictionY * friction1;
-                body2.velocity.x -= frictionX * friction2;
-                body2.velocity.y -= frictionY * friction2;
-            }
+        for (let i = 0; i < n; i++) {
+            const body = bodies[i];
+            const speed = Math.sqrt(body.velocity.x * body.velocity.x + body.velocity.y * body.velocity.y);
+            this.collisionGridX[i] = body.position.x;
+            this.collisionGridY[i] = body.position.y;
+            this.collisionGridRadius[i] = body.radius + speed * timeStep;
         }
         
-        // Note: Energy loss is controlled by restitution coefficient
-        // Additional damping removed to allow proper elastic behavior
+        this.collisionGrid.build(this.collisionGridX, this.collisionGridY, this.collisionGridRadius, n);
+        return this.collisionGrid;
     }
 
     // Handle inelastic collisions (bodies merge when they collide)
-    handleInelasticCollisions(bodies) {
+    handleInelasticCollisions(bodies, timeStep) {
         const bodiesToRemove = new Set();
         const bodiesToAdd = [];
+        const candidates = this.costProfile.enabled ? this.costProfile.collisionCandidates : null;
         
-        for (let i = 0; i < bodies.length; i++) {
-            if (bodiesToRemove.has(i)) continue;
+        // Merge the first touching partner found for each body
+        const mergeIfTouching = (i, j) => {
+            if (candidates) {
+                candidates[i]++;
+                candidates[j]++;
+            }
+            if (bodiesToRemove.has(i) || bodiesToRemove.has(j)) return;
             
-            for (let j = i + 1; j < bodies.length; j++) {
-                if (bodiesToRemove.has(j)) continue;
-                
-                const body1 = bodies[i];
-                const body2 = bodies[j];
-                
-                // Calculate distance between centers
-                const dx = body1.position.x - body2.position.x;
-                const dy = body1.position.y - body2.position.y;
-                const centerDistance = Math.sqrt(dx * dx + dy * dy);
-                
-                // Check if surfaces are touching or overlapping
-                const radiusSum = body1.radius + body2.radius;
+            const body1 = bodies[i];
+            const body2 = bodies[j];
+            
+            // Check if surfaces are touching or overlapping
+            const dx = body1.position.x - body2.position.x;
+            const dy = body1.position.y - body2.position.y;
+            const radiusSum = body1.radius + body2.radius;
+            
+            if (dx * dx + dy * dy <= radiusSum * radiusSum) {
+                bodiesToAdd.push(Body.merge(body1, body2));
                 
-                if (centerDistance <= radiusSum) {
-                    // Create merged body
-                    const merged = Body.merge(body1, body2);
-                    bodiesToAdd.push(merged);
-                    
-                    // Mark original bodies for removal
-                    bodiesToRemove.add(i);
-                    bodiesToRemove.add(j);
-                    
-                    break; // Body1 can only collide with one body per frame
-                }
+                // Mark original bodies for removal
+                bodiesToRemove.add(i);
+                bodiesToRemove.add(j);
+            }
+        };
+        
+        if (this.useNeighborLists) {
+            // Only neighbor-list pairs can be touching
+            const list = this.updateNeighborList(bodies, timeStep);
+            for (let p = 0; p < list.pairCount; p++) {
+                mergeIfTouching(list.pairA[p], list.pairB[p]);
             }
+        } else {
+            this.buildCollisionGrid(bodies, timeStep).forEachCandidatePair(mergeIfTouching);
         }
         
         // Remove collided bodies (in reverse order to maintain indices)
         const indicesToRemove = Array.from(bodiesToRemove).sort((a, b) => b - a);
         indicesToRemove.forEach(index => {
-            const removedBody = bodies[index];
-            // Clean up collision cooldowns for remaining bodies
-            bodies.forEach(body => {
-                if (body !== removedBody) {
-                    body.collisionCooldowns.delete(removedBody.id);
-                }
-            });
             bodies.splice(index, 1);
         });
         
@@ -642,6 +996,53 @@ class PhysicsEngine {
         bodies.push(...bodiesToAdd);
     }
 
+    // Append a batch of bodies and give them their initial forces in one pass. Small
+    // batches are summed directly; larger ones share a single tree build and walk only
+    // the new bodies. Existing bodies pick up the new ones at the next step, whose force
+    // pass recomputes every body's force from scratch.
+    insertBodies(bodies, newBodies) {
+        const firstIndex = bodies.length;
+        for (const body of newBodies) {
+            bodies.push(body);
+        }
+        if (newBodies.length === 0) return 0;
+        
+        const n = bodies.length;
+        if (newBodies.length * n <= PHYSICS_CONSTANTS.BATCH_INSERT_DIRECT_PAIRS) {
+            const softeningSquared = this.softeningParameter * this.softeningParameter;
+            for (let i = firstIndex; i < n; i++) {
+                const body = bodies[i];
+                let ax = 0;
+                let ay = 0;
+                for (let j = 0; j < n; j++) {
+                    if (j === i) continue;
+                    const other = bodies[j];
+                    const dx = other.position.x - body.position.x;
+                    const dy = other.position.y - body.position.y;
+                    const distanceSquared = dx * dx + dy * dy + softeningSquared;
+                    const scale = this.gravitationalConstant * other.mass / (distanceSquared * Math.sqrt(distanceSquared));
+                    ax += dx * scale;
+                    ay += dy * scale;
+                }
+                body.force.x = ax * body.mass;
+                body.force.y = ay * body.mass;
+            }
+        } else {
+            this.optimizedBarnesHut.setTheta(this.barnesHutTheta);
+            const accelerations = this.optimizedBarnesHut.calculateForcesFrom(
+                bodies, firstIndex, this.gravitationalConstant, this.softeningParameter
+            );
+            for (let i = firstIndex; i < n; i++) {
+                const acceleration = accelerations[i - firstIndex];
+                bodies[i].force.x = acceleration.x * bodies[i].mass;
+                bodies[i].force.y = acceleration.y * bodies[i].mass;
+            }
+        }
+        
+        this.energyCacheValid = false;
+        return newBodies.length;
+    }
+
     // Calculate total system energy with improved accuracy and caching
     calculateTotalEnergy(bodies) {
         // Only recalculate if needed (when bodies have moved)
@@ -664,6 +1065,16 @@ class PhysicsEngine {
             body.kineticEnergy = kineticEnergy;
         });
         
+        // Keep the last audited potential; the O(N²) sum runs as a background job
+        if (this.deferPotentialEnergy) {
+            this.potentialEnergyKnown = this.deferredPotentialEnergy !== null;
+            this.totalPotentialEnergy = (this.deferredPotentialEnergy || 0) +
+                this.forceFields.potentialEnergy(bodies, this.gravitationalConstant);
+            this.totalEnergy = this.totalKineticEnergy + this.totalPotentialEnergy;
+            return;
+        }
+        this.potentialEnergyKnown = true;
+        
         // Calculate potential energy with improved precision
         // Use Kahan summation for better numerical accuracy
         let potentialSum = 0;
@@ -692,7 +1103,7 @@ class PhysicsEngine {
             }
         }
         
-        this.totalPotentialEnergy = potentialSum;
+        this.totalPotentialEnergy = potentialSum + this.forceFields.potentialEnergy(bodies, this.gravitationalConstant);
         this.totalEnergy = this.totalKineticEnergy + this.totalPotentialEnergy;
     }
 
@@ -710,6 +1121,26 @@ class PhysicsEngine {
         return centerOfMass.divide(totalMass);
     }
 
+    // Accept the result of a background potential-energy audit, unless it measured an
+    // earlier scene
+    setDeferredPotentialEnergy(potentialEnergy, bodies, generation) {
+        if (generation !== this.energyGeneration) return false;
+        
+        this.deferredPotentialEnergy = potentialEnergy;
+        this.potentialEnergyKnown = true;
+        this.totalPotentialEnergy = potentialEnergy + this.forceFields.potentialEnergy(bodies, this.gravitationalConstant);
+        this.totalEnergy = this.totalKineticEnergy + this.totalPotentialEnergy;
+        return true;
+    }
+
+    // A new scene: forget the audited potential and the energy history of the old one
+    resetEnergyTracking(generation = this.energyGeneration + 1) {
+        this.energyGeneration = generation;
+        this.deferredPotentialEnergy = null;
+        this.potentialEnergyKnown = false;
+        this.energyHistory = [];
+    }
+
     // Get total momentum
     getTotalMomentum(bodies) {
         let totalMomentum = new Vector2D(0, 0);
@@ -733,13 +1164,14 @@ class PhysicsEngine {
         return totalAngularMomentum;
     }
 
-    // Apply external forces (e.g., drag, external fields)
-    applyExternalForces(bodies, forces) {
-        bodies.forEach((body, index) => {
-            if (forces[index]) {
-                body.applyForce(forces[index]);
-            }
-        });
+    // Replace the external force fields (see ForceFieldSet for the spec format)
+    setForceFields(specs) {
+        this.forceFields.setFields(specs);
+        this.energyCacheValid = false;
+    }
+
+    getForceFields() {
+        return this.forceFields.toJSON();
     }
 
     // Stabilize system by removing center of mass velocity
@@ -801,6 +1233,8 @@ class PhysicsEngine {
             }
         }
 
+        potentialEnergy += this.forceFields.potentialEnergy(bodies, this.gravitationalConstant);
+        
         return {
             totalMass,
             kineticEnergy,
@@ -814,7 +1248,8 @@ class PhysicsEngine {
         return {
             kinetic: this.totalKineticEnergy,
             potential: this.totalPotentialEnergy,
-            total: this.totalEnergy
+            total: this.totalEnergy,
+            potentialKnown: this.potentialEnergyKnown
         };
     }
 
@@ -824,9 +1259,16 @@ class PhysicsEngine {
             physicsTime: this.physicsTime,
             forceCalculationTime: this.forceCalculationTime,
             integrationTime: this.integrationTime,
+            frameTimings: this.frameTimings,
             bodyCount: this.currentBodyCount,
             method: this.forceCalculationMethod,
-            integrationMethod: this.integrationMethod
+            integrationMethod: this.integrationMethod,
+            neighborList: this.neighborList.getStats(),
+            sleep: this.sleepManager.getStats(),
+            contacts: this.contactSolver.getStats(),
+            kernels: this.kernelGenerator.getStats(),
+            escapers: this.escapers.getStats(),
+            multipleTimeStepping: this.getMultipleTimeSteppingStats()
         };
     }
     
@@ -913,6 +1355,96 @@ class PhysicsEngine {
         if (config.useDoublePrecision !== undefined) {
             this.useDoublePrecision = config.useDoublePrecision;
         }
+        
+        if (config.gravitationalConstant !== undefined) {
+            this.gravitationalConstant = config.gravitationalConstant;
+        }
+        
+        if (config.softeningParameter !== undefined) {
+            this.softeningParameter = config.softeningParameter;
+        }
+        
+        if (config.collisionEnabled !== undefined) {
+            this.collisionEnabled = config.collisionEnabled;
+        }
+        
+        if (config.collisionType !== undefined) {
+            this.collisionType = config.collisionType;
+        }
+        
+        if (config.restitutionCoefficient !== undefined) {
+            this.setRestitutionCoefficient(config.restitutionCoefficient);
+        }
+        
+        if (config.timeScale !== undefined) {
+            this.timeScale = config.timeScale;
+        }
+        
+        if (config.useNeighborLists !== undefined) {
+            this.useNeighborLists = config.useNeighborLists;
+        }
+        
+        if (config.forceFields !== undefined) {
+            this.setForceFields(config.forceFields);
+        }
+        
+        if (config.useSpecializedKernels !== undefined) {
+            this.useSpecializedKernels = config.useSpecializedKernels;
+        }
+        
+        if (config.escaperArchival !== undefined) {
+            this.escapers.enabled = config.escaperArchival;
+        }
+        
+        if (config.escapeRadius !== undefined) {
+            this.escapers.escapeRadius = Math.max(0, config.escapeRadius);
+        }
+        
+        if (config.multipleTimeStepping !== undefined) {
+            this.multipleTimeStepping = config.multipleTimeStepping;
+        }
+        
+        // The tuned interval restarts from a newly configured one, but repeating the same
+        // setting (as every worker step does) leaves the tuning alone
+        if (config.farFieldInterval !== undefined && config.farFieldInterval !== this.farFieldInterval) {
+            this.farFieldInterval = Math.max(1, Math.min(PHYSICS_CONSTANTS.FAR_FIELD_MAX_INTERVAL,
+                Math.round(config.farFieldInterval) || 1));
+            this.multipleTimeStep.interval = this.farFieldInterval;
+        }
+        
+        if (config.autoTuneFarFieldInterval !== undefined) {
+            this.autoTuneFarFieldInterval = config.autoTuneFarFieldInterval;
+        }
+        
+        if (config.costProfiling !== undefined && config.costProfiling !== this.costProfile.enabled) {
+            this.costProfile.setEnabled(config.costProfiling);
+        }
+    }
+
+    // Get the settings needed to reproduce this engine's behaviour elsewhere (e.g. in the physics worker)
+    getConfiguration() {
+        return {
+            integrationMethod: this.integrationMethod,
+            forceCalculationMethod: this.forceCalculationMethod,
+            adaptiveTimeStep: this.adaptiveTimeStep,
+            barnesHutTheta: this.barnesHutTheta,
+            useDoublePrecision: this.useDoublePrecision,
+            gravitationalConstant: this.gravitationalConstant,
+            softeningParameter: this.softeningParameter,
+            collisionEnabled: this.collisionEnabled,
+            collisionType: this.collisionType,
+            restitutionCoefficient: this.restitutionCoefficient,
+            timeScale: this.timeScale,
+            useNeighborLists: this.useNeighborLists,
+            forceFields: this.forceFields.toJSON(),
+            useSpecializedKernels: this.useSpecializedKernels,
+            escaperArchival: this.escapers.enabled,
+            escapeRadius: this.escapers.escapeRadius,
+            multipleTimeStepping: this.multipleTimeStepping,
+            farFieldInterval: this.farFieldInterval,
+            autoTuneFarFieldInterval: this.autoTuneFarFieldInterval,
+            costProfiling: this.costProfile.enabled
+        };
     }
 
     // Configuration setters
@@ -959,6 +1491,35 @@ class PhysicsEngine {
         }
     }
 
+    // Lower the energy history length, dropping the oldest entries beyond it
+    setEnergyHistoryLimit(limit) {
+        this.maxEnergyHistory = Math.max(1, Math.floor(limit));
+        if (this.energyHistory.length > this.maxEnergyHistory) {
+            this.energyHistory.splice(0, this.energyHistory.length - this.maxEnergyHistory);
+        }
+    }
+
+    /**
+     * Working buffers held by the engine for the memory ledger: typed arrays of the
+     * force, neighbor, collision and profiling passes plus the last Barnes-Hut tree.
+     * The bodies themselves are not included.
+     */
+    getMemoryUsage() {
+        const contactSolver = this.contactSolver;
+        const bytes = MemoryLedger.typedArrayBytes([
+            this, this.multipleTimeStep, this.kernelBuffers, this.costProfile,
+            this.neighborList, this.neighborList.grid, this.collisionGrid,
+            contactSolver, contactSolver.islands, this.sleepManager, this.sleepManager.islands
+        ]);
+        const tree = this.optimizedBarnesHut.tree ? this.optimizedBarnesHut.tree.getMemoryStats() : null;
+        const objects = (tree ? tree.nodes : 0) + contactSolver.impulseCache.size + contactSolver.nextImpulseCache.size;
+        
+        return {
+            bytes: bytes + (tree ? tree.bytes : 0) + objects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES,
+            objects
+        };
+    }
+
     // Calculate kinetic energy for a subset of bodies (for collision validation)
     calculateKineticEnergySubset(bodies) {
         return bodies.reduce((total, body) => {
@@ -1006,7 +1567,8 @@ class PhysicsEngine {
                this.gpuPhysics.isReady() && 
                bodyCount >= this.gpuPhysicsThreshold &&
                bodyCount <= this.gpuPhysics.maxBodies &&
-               !this.collisionEnabled; // GPU physics doesn't handle collisions yet
+               !this.collisionEnabled && // GPU physics doesn't handle collisions yet
+               !this.forceFields.hasFields(); // ...or external fields
     }
 
     // Set force calculation method with automatic GPU detection
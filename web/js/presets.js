@@ -161,6 +161,44 @@ class Presets {
         return bodies;
     }
 
+    // Stellar disc inside a static logarithmic dark-matter halo (see getForceFields);
+    // the halo is an external field, so no halo particles are simulated
+    static haloGalaxy() {
+        const bodies = [];
+        const G = PHYSICS_CONSTANTS.GRAVITATIONAL_CONSTANT;
+        const centralMass = 200;
+        const halo = new ForceFieldSet();
+        halo.setFields(this.getForceFields('halo-galaxy'));
+        const numStars = 150;
+        
+        bodies.push(new Body(
+            new Vector2D(0, 0),
+            new Vector2D(0, 0),
+            centralMass,
+            '#ffd54f',
+            10
+        ));
+        
+        const colors = ['#64ffda', '#bb86fc', '#03dac6', '#90caf9'];
+        for (let i = 0; i < numStars; i++) {
+            const radius = 40 + Math.sqrt(Math.random()) * 310;
+            const angle = Math.random() * Math.PI * 2;
+            
+            // Circular speed from the central mass plus the halo
+            const orbitalVelocity = Math.sqrt(G * centralMass / radius + halo.circularVelocitySquared(radius, G));
+            
+            bodies.push(new Body(
+                new Vector2D(radius * Math.cos(angle), radius * Math.sin(angle)),
+                new Vector2D(-orbitalVelocity * Math.sin(angle), orbitalVelocity * Math.cos(angle)),
+                0.5 + Math.random(),
+                colors[Math.floor(Math.random() * colors.length)],
+                40
+            ));
+        }
+        
+        return bodies;
+    }
+
     static chaos() {
         const bodies = [];
         const numBodies = 15;
@@ -355,6 +393,8 @@ class Presets {
                 return this.binaryStars();
             case 'galaxy':
                 return this.galaxy();
+            case 'halo-galaxy':
+                return this.haloGalaxy();
             case 'chaos':
                 return this.chaos();
             case 'earth-moon':
@@ -370,11 +410,22 @@ class Presets {
         }
     }
 
+    // External force fields a preset runs with (empty for self-gravitating presets)
+    static getForceFields(name) {
+        switch (name) {
+            case 'halo-galaxy':
+                return [{ type: FORCE_FIELD_TYPE.LOGARITHMIC_HALO, x: 0, y: 0, velocity: 45, coreRadius: 60 }];
+            default:
+                return [];
+        }
+    }
+
     static getAllPresets() {
         return [
             { id: 'solar-system', name: 'Solar System', description: 'A simplified solar system with planets orbiting the sun' },
             { id: 'binary-stars', name: 'Binary Stars', description: 'Two stars orbiting around their common center of mass' },
             { id: 'galaxy', name: 'Galaxy', description: 'A spiral galaxy with a central black hole' },
+            { id: 'halo-galaxy', name: 'Halo Galaxy', description: 'A stellar disc held by a static dark-matter halo field' },
             { id: 'chaos', name: 'Chaos', description: 'Random bodies with chaotic interactions' },
             { id: 'earth-moon', name: 'Earth-Moon', description: 'Earth and Moon system' },
             { id: 'double-pendulum', name: 'Double Pendulum', description: 'A chaotic double pendulum system' },
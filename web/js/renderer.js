@@ -623,6 +623,19 @@ class Renderer {
     calculateOrbitPreview(previewBody, existingBodies, physicsEngine) {
         this.orbitPreviewPoints = [];
         
+        // One dominant body: draw its two-body conic instead of integrating the system
+        const dominant = OrbitPreview.findDominantBody(previewBody, existingBodies,
+            physicsEngine.gravitationalConstant, physicsEngine.softeningParameter);
+        if (dominant && dominant.share >= RENDERING_CONSTANTS.CONIC_PREVIEW_DOMINANCE) {
+            const conic = OrbitPreview.conic(previewBody, dominant.body,
+                physicsEngine.gravitationalConstant, RENDERING_CONSTANTS.CONIC_PREVIEW_POINTS);
+            if (conic) {
+                conic.perturbation = dominant.perturbation;
+                this.orbitPreviewPoints = conic.points;
+                return conic;
+            }
+        }
+        
         // Find the primary body to orbit around
         const targetBody = this.findPrimaryBody(previewBody.position, existingBodies);
         if (!targetBody) return { points: [], stable: false, collision: false };
@@ -0,0 +1,100 @@
+/**
+ * Dynamic resolution
+ * Picks the scale at which the scene is rendered, as a fraction of the display
+ * canvas resolution, from the measured cost of rendering a frame. The frame interval
+ * would also count physics and worker waits, which a lower resolution does not
+ * shorten, so a physics-bound scene would be downscaled for nothing. Slow renders
+ * lower the scale at once; raising it is a probe made only after a sustained run on
+ * target, and a probe that has to be undone waits twice as long before the next, so
+ * a vsync-locked display does not oscillate between two scales.
+ */
+
+class ResolutionScaler {
+    constructor() {
+        this.enabled = true;
+        this.minScale = RENDERING_CONSTANTS.RENDER_SCALE_MIN;
+        this.maxScale = RENDERING_CONSTANTS.RENDER_SCALE_MAX;
+        this.targetRenderTime = RENDERING_CONSTANTS.RENDER_SCALE_TARGET_RENDER_TIME;
+        this.scale = this.maxScale;
+        
+        this.averageRenderTime = 0; // Exponential moving average of the render cost (ms)
+        this.framesSinceChange = 0;
+        this.probeFrames = RENDERING_CONSTANTS.RENDER_SCALE_PROBE_FRAMES; // Frames on target before the next raise
+        this.probing = false; // The last change was a raise that has not yet proven itself
+    }
+
+    /**
+     * Feed the time (ms) the last frame took to render and return the scale to render
+     * the next one at
+     */
+    update(renderTime) {
+        if (!this.enabled) {
+            this.scale = this.maxScale;
+            return this.scale;
+        }
+        
+        // One-off stalls (breakpoints, a trail layer rebuild) say nothing about fill cost
+        if (renderTime <= 0 || renderTime > 250) return this.scale;
+        this.averageRenderTime = this.averageRenderTime === 0 ? renderTime :
+            this.averageRenderTime + (renderTime - this.averageRenderTime) * 0.1;
+        this.framesSinceChange++;
+        
+        const step = RENDERING_CONSTANTS.RENDER_SCALE_STEP;
+        if (this.averageRenderTime > this.targetRenderTime * 1.15) {
+            if (this.scale > this.minScale && this.framesSinceChange >= RENDERING_CONSTANTS.RENDER_SCALE_SETTLE_FRAMES) {
+                if (this.probing) {
+                    this.probeFrames *= 2;
+                }
+                this.setScale(this.scale - step);
+                this.probing = false;
+            }
+        } else if (this.averageRenderTime <= this.targetRenderTime * 1.05) {
+            if (this.probing && this.framesSinceChange >= this.probeFrames) {
+                // The raise held up; later probes may come sooner again
+                this.probing = false;
+                this.probeFrames = RENDERING_CONSTANTS.RENDER_SCALE_PROBE_FRAMES;
+            }
+            if (this.scale < this.maxScale && this.framesSinceChange >= this.probeFrames) {
+                this.setScale(this.scale + step);
+                this.probing = true;
+            }
+        }
+        
+        return this.scale;
+    }
+
+    setScale(scale) {
+        // Rounded so repeated steps land on the same few render target sizes
+        this.scale = Math.round(Math.min(this.maxScale, Math.max(this.minScale, scale)) * 100) / 100;
+        this.framesSinceChange = 0;
+        this.averageRenderTime = 0;
+    }
+
+    setBounds(minScale, maxScale) {
+        this.minScale = Math.min(1, Math.max(0.1, minScale));
+        this.maxScale = Math.min(1, Math.max(this.minScale, maxScale));
+        this.setScale(this.scale);
+    }
+
+    setEnabled(enabled) {
+        this.enabled = enabled;
+        this.probeFrames = RENDERING_CONSTANTS.RENDER_SCALE_PROBE_FRAMES;
+        this.probing = false;
+        this.setScale(enabled ? this.scale : this.maxScale);
+    }
+
+    getStats() {
+        return {
+            enabled: this.enabled,
+            renderScale: this.scale,
+            minScale: this.minScale,
+            maxScale: this.maxScale,
+            averageRenderTime: this.averageRenderTime
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { ResolutionScaler };
+}
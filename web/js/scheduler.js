@@ -0,0 +1,377 @@
+/**
+ * Cooperative, time-sliced task scheduler
+ * Long jobs are written as generators that yield now and then (optionally with a
+ * progress fraction). The scheduler advances them a little each frame within a time
+ * budget, so a long computation never blocks input for more than one frame.
+ * Jobs registered in SCHEDULER_JOBS only need plain data and can be handed to the
+ * physics worker instead; the caller sees the same callbacks either way.
+ */
+
+const TASK_PRIORITY = {
+    HIGH: 0,    // Directly requested by the user (e.g. imports)
+    NORMAL: 1,  // Interactive feedback (e.g. previews)
+    LOW: 2      // Background bookkeeping (e.g. energy audits)
+};
+
+/**
+ * Jobs that can run on either thread. Each takes a structured-cloneable payload,
+ * yields progress in [0, 1] and returns a structured-cloneable result.
+ */
+const SCHEDULER_JOBS = {
+    /**
+     * Softened gravitational potential energy of the whole system, O(N²)
+     * payload: { x, y, mass (Float64Array), gravitationalConstant, softeningParameter }
+     */
+    'energy-audit': function* (payload) {
+        const { x, y, mass, gravitationalConstant, softeningParameter } = payload;
+        const n = mass.length;
+        const softeningSquared = softeningParameter * softeningParameter;
+        const pairsPerSlice = 4000;
+        
+        let potential = 0;
+        let compensation = 0;
+        let pairsSinceYield = 0;
+        
+        for (let i = 0; i < n; i++) {
+            let rowSum = 0;
+            for (let j = i + 1; j < n; j++) {
+                const dx = x[i] - x[j];
+                const dy = y[i] - y[j];
+                rowSum -= gravitationalConstant * mass[i] * mass[j] / Math.sqrt(dx * dx + dy * dy + softeningSquared);
+            }
+            
+            // Kahan summation across rows, as in PhysicsEngine.calculateTotalEnergy
+            const adjusted = rowSum - compensation;
+            const sum = potential + adjusted;
+            compensation = (sum - potential) - adjusted;
+            potential = sum;
+            
+            pairsSinceYield += n - i - 1;
+            if (pairsSinceYield >= pairsPerSlice) {
+                pairsSinceYield = 0;
+                yield (i + 1) / n;
+            }
+        }
+        
+        return { potentialEnergy: potential, bodyCount: n };
+    },
+
+    /**
+     * Long-term path of a test body. The heaviest bodies of the field are integrated
+     * with it (leapfrog), so the cost per step stays bounded for large scenes.
+     * payload: { x, y, vx, vy, mass, radius (Float64Array, field bodies),
+     *            test: { x, y, vx, vy, mass, radius }, gravitationalConstant,
+     *            softeningParameter, timeStep, steps, maxPoints, maxFieldBodies }
+     */
+    'orbit-prediction': function* (payload) {
+        const { test, gravitationalConstant, softeningParameter, timeStep } = payload;
+        
+        // Keep the most massive field bodies, then append the test body last
+        const order = Array.from(payload.mass.keys())
+            .sort((a, b) => payload.mass[b] - payload.mass[a])
+            .slice(0, payload.maxFieldBodies);
+        const n = order.length + 1;
+        const px = new Float64Array(n);
+        const py = new Float64Array(n);
+        const vx = new Float64Array(n);
+        const vy = new Float64Array(n);
+        const m = new Float64Array(n);
+        const r = new Float64Array(n);
+        const ax = new Float64Array(n);
+        const ay = new Float64Array(n);
+        
+        order.forEach((index, k) => {
+            px[k] = payload.x[index];
+            py[k] = payload.y[index];
+            vx[k] = payload.vx[index];
+            vy[k] = payload.vy[index];
+            m[k] = payload.mass[index];
+            r[k] = payload.radius[index];
+        });
+        const t = n - 1;
+        px[t] = test.x;
+        py[t] = test.y;
+        vx[t] = test.vx;
+        vy[t] = test.vy;
+        m[t] = test.mass;
+        r[t] = test.radius;
+        
+        const softeningSquared = softeningParameter * softeningParameter;
+        const accelerate = () => {
+            ax.fill(0);
+            ay.fill(0);
+            for (let i = 0; i < n; i++) {
+                for (let j = i + 1; j < n; j++) {
+                    const dx = px[j] - px[i];
+                    const dy = py[j] - py[i];
+                    const distanceSquared = dx * dx + dy * dy + softeningSquared;
+                    const inverseCube = gravitationalConstant / (distanceSquared * Math.sqrt(distanceSquared));
+                    ax[i] += dx * inverseCube * m[j];
+                    ay[i] += dy * inverseCube * m[j];
+                    ax[j] -= dx * inverseCube * m[i];
+                    ay[j] -= dy * inverseCube * m[i];
+                }
+            }
+        };
+        
+        const recordEvery = Math.max(1, Math.ceil(payload.steps / payload.maxPoints));
+        const stepsPerSlice = Math.max(1, Math.floor(4000 / (n * n)));
+        const points = [{ x: px[t], y: py[t] }];
+        let collision = false;
+        
+        accelerate();
+        for (let step = 1; step <= payload.steps; step++) {
+            // Kick-drift-kick leapfrog
+            for (let i = 0; i < n; i++) {
+                vx[i] += ax[i] * timeStep * 0.5;
+                vy[i] += ay[i] * timeStep * 0.5;
+                px[i] += vx[i] * timeStep;
+                py[i] += vy[i] * timeStep;
+            }
+            accelerate();
+            for (let i = 0; i < n; i++) {
+                vx[i] += ax[i] * timeStep * 0.5;
+                vy[i] += ay[i] * timeStep * 0.5;
+            }
+            
+            if (step % recordEvery === 0) {
+                points.push({ x: px[t], y: py[t] });
+            }
+            
+            for (let i = 0; i < t; i++) {
+                const dx = px[i] - px[t];
+                const dy = py[i] - py[t];
+                const reach = r[i] + r[t];
+                if (dx * dx + dy * dy < reach * reach) {
+                    collision = true;
+                    break;
+                }
+            }
+            if (collision) {
+                points.push({ x: px[t], y: py[t] });
+                break;
+            }
+            
+            if (step % stepsPerSlice === 0) {
+                yield step / payload.steps;
+            }
+        }
+        
+        return { points, collision };
+    },
+
+    /**
+     * Friends-of-friends group catalog (see GroupFinder.find for the payload)
+     */
+    'group-catalog': function* (payload) {
+        return yield* GroupFinder.find(payload);
+    },
+
+    /**
+     * Dominant attractor and orbital elements of every body (see OrbitalElements.compute)
+     */
+    'orbital-elements': function* (payload) {
+        return yield* OrbitalElements.compute(payload);
+    }
+};
+
+class TaskScheduler {
+    constructor(frameBudget = PHYSICS_CONSTANTS.SCHEDULER_FRAME_BUDGET) {
+        this.frameBudget = frameBudget; // Milliseconds of job work per frame
+        this.tasks = []; // Local tasks in scheduling order
+        this.remoteTasks = new Map(); // jobId -> task running in the worker
+        this.nextTaskId = 1;
+        this.worker = null;
+        
+        this.stats = {
+            completed: 0,
+            cancelled: 0,
+            offloaded: 0,
+            lastSliceTime: 0
+        };
+    }
+
+    /**
+     * Route registry jobs to this worker from now on (null runs everything locally)
+     */
+    setWorker(worker) {
+        this.worker = worker;
+        
+        // Remote tasks cannot finish without their worker; run them here instead
+        if (!worker && this.remoteTasks.size > 0) {
+            const orphaned = Array.from(this.remoteTasks.values());
+            this.remoteTasks.clear();
+            orphaned.forEach(task => {
+                task.iterator = SCHEDULER_JOBS[task.job.type](task.job.payload);
+                this.tasks.push(task);
+            });
+        }
+    }
+
+    /**
+     * Queue a job.
+     * job: { type, payload } for a SCHEDULER_JOBS entry, or { run: generator function }
+     * options: { priority, key, onProgress, onComplete, onError, onCancel }
+     * A job scheduled with the same key as a pending one replaces it.
+     * Returns a handle with the task id and a cancel() method.
+     */
+    schedule(job, options = {}) {
+        if (options.key) {
+            this.cancelKey(options.key);
+        }
+        
+        const task = {
+            id: this.nextTaskId++,
+            job,
+            key: options.key || null,
+            priority: options.priority !== undefined ? options.priority : TASK_PRIORITY.NORMAL,
+            onProgress: options.onProgress || null,
+            onComplete: options.onComplete || null,
+            onError: options.onError || null,
+            onCancel: options.onCancel || null,
+            iterator: null,
+            progress: 0
+        };
+        
+        const shared = job.type && SCHEDULER_JOBS[job.type];
+        if (!shared && typeof job.run !== 'function') {
+            throw new Error(`Unknown job type: ${job.type}`);
+        }
+        
+        if (shared && this.worker) {
+            this.remoteTasks.set(task.id, task);
+            this.worker.postMessage({
+                type: 'job',
+                data: { jobId: task.id, jobType: job.type, payload: job.payload }
+            });
+            this.stats.offloaded++;
+        } else {
+            task.iterator = shared ? shared(job.payload) : job.run();
+            this.tasks.push(task);
+        }
+        
+        return { id: task.id, cancel: () => this.cancel(task.id) };
+    }
+
+    cancel(taskId) {
+        let task = null;
+        const index = this.tasks.findIndex(candidate => candidate.id === taskId);
+        if (index >= 0) {
+            task = this.tasks[index];
+            this.tasks.splice(index, 1);
+            if (task.iterator && task.iterator.return) task.iterator.return();
+        } else if (this.remoteTasks.has(taskId)) {
+            task = this.remoteTasks.get(taskId);
+            this.remoteTasks.delete(taskId);
+            if (this.worker) {
+                this.worker.postMessage({ type: 'job-cancel', data: { jobId: taskId } });
+            }
+        }
+        
+        if (task) {
+            this.stats.cancelled++;
+            if (task.onCancel) task.onCancel();
+        }
+        return task !== null;
+    }
+
+    cancelKey(key) {
+        const ids = [];
+        this.tasks.forEach(task => { if (task.key === key) ids.push(task.id); });
+        this.remoteTasks.forEach(task => { if (task.key === key) ids.push(task.id); });
+        ids.forEach(id => this.cancel(id));
+    }
+
+    hasPendingTasks(key = null) {
+        if (key === null) return this.tasks.length > 0 || this.remoteTasks.size > 0;
+        
+        return this.tasks.some(task => task.key === key) ||
+            Array.from(this.remoteTasks.values()).some(task => task.key === key);
+    }
+
+    /**
+     * Advance local tasks, highest priority first (oldest first within a priority),
+     * until the budget is used up
+     */
+    run(budget = this.frameBudget) {
+        if (this.tasks.length === 0) return;
+        
+        const startTime = performance.now();
+        const deadline = startTime + budget;
+        
+        while (this.tasks.length > 0 && performance.now() < deadline) {
+            let task = this.tasks[0];
+            for (let i = 1; i < this.tasks.length; i++) {
+                if (this.tasks[i].priority < task.priority) task = this.tasks[i];
+            }
+            
+            let step;
+            try {
+                step = task.iterator.next();
+            } catch (error) {
+                this.removeTask(task);
+                if (task.onError) {
+                    task.onError(error);
+                } else {
+                    console.error(`Scheduled job ${task.job.type || task.id} failed:`, error);
+                }
+                continue;
+            }
+            
+            if (step.done) {
+                this.removeTask(task);
+                this.stats.completed++;
+                if (task.onComplete) task.onComplete(step.value);
+            } else if (typeof step.value === 'number') {
+                task.progress = step.value;
+                if (task.onProgress) task.onProgress(step.value);
+            }
+        }
+        
+        this.stats.lastSliceTime = performance.now() - startTime;
+    }
+
+    removeTask(task) {
+        const index = this.tasks.indexOf(task);
+        if (index >= 0) this.tasks.splice(index, 1);
+    }
+
+    /**
+     * Handle job messages from the worker. Returns true when the message was a job reply.
+     */
+    handleWorkerMessage(type, data) {
+        if (type !== 'job-progress' && type !== 'job-result' && type !== 'job-error') return false;
+        
+        const task = this.remoteTasks.get(data.jobId);
+        if (!task) return true; // Cancelled meanwhile
+        
+        if (type === 'job-progress') {
+            task.progress = data.progress;
+            if (task.onProgress) task.onProgress(data.progress);
+        } else {
+            this.remoteTasks.delete(data.jobId);
+            if (type === 'job-result') {
+                this.stats.completed++;
+                if (task.onComplete) task.onComplete(data.result);
+            } else if (task.onError) {
+                task.onError(new Error(data.message));
+            } else {
+                console.error(`Worker job ${task.job.type} failed:`, data.message);
+            }
+        }
+        return true;
+    }
+
+    getStats() {
+        return {
+            ...this.stats,
+            pending: this.tasks.length,
+            remote: this.remoteTasks.size
+        };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { TASK_PRIORITY, SCHEDULER_JOBS, TaskScheduler };
+}
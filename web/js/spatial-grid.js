@@ -0,0 +1,193 @@
+/**
+ * Hierarchical hashed grid broadphase
+ * Each entry lives in a single cell at the level whose cell size matches its
+ * diameter, so one large body no longer forces huge cells on small debris.
+ * Entries search their own level and every coarser occupied level, which keeps
+ * the candidate count near-linear for widely varying radii.
+ */
+
+class MultiLevelGrid {
+    constructor() {
+        this.baseCellSize = 1;
+        this.levelCount = 0;
+        this.count = 0;
+        
+        // Per-entry data, reused between builds
+        this.x = new Float64Array(0);
+        this.y = new Float64Array(0);
+        this.level = new Int32Array(0);
+        this.bucketOfEntry = new Int32Array(0);
+        
+        // One hash table shared by all levels (bucket -> run of entries)
+        this.bucketStart = new Int32Array(0);
+        this.bucketEntries = new Int32Array(0);
+        
+        // Occupied levels in ascending order
+        this.occupiedLevels = [];
+        this.levelCellSize = [];
+        
+        this.stats = {
+            levels: 0,
+            candidatePairs: 0,
+            buildTime: 0
+        };
+    }
+
+    /**
+     * Place n entries given their centres and radii (anything within radiusA + radiusB
+     * of each other will be reported as a candidate pair)
+     */
+    build(xs, ys, radii, n) {
+        const startTime = performance.now();
+        this.ensureCapacity(n);
+        this.count = n;
+        
+        let minRadius = Infinity;
+        let maxRadius = 0;
+        for (let i = 0; i < n; i++) {
+            minRadius = Math.min(minRadius, radii[i]);
+            maxRadius = Math.max(maxRadius, radii[i]);
+        }
+        if (n === 0) {
+            this.stats.levels = 0;
+            return;
+        }
+        
+        // Level l has cells of baseCellSize * 2^l; an entry goes to the first level
+        // whose cells are at least its diameter
+        this.baseCellSize = Math.max(2 * minRadius, 1e-6);
+        this.levelCount = 1;
+        while (this.baseCellSize * Math.pow(2, this.levelCount - 1) < 2 * maxRadius) {
+            this.levelCount++;
+        }
+        
+        this.levelCellSize.length = this.levelCount;
+        for (let l = 0; l < this.levelCount; l++) {
+            this.levelCellSize[l] = this.baseCellSize * Math.pow(2, l);
+        }
+        
+        const occupied = new Uint8Array(this.levelCount);
+        const tableSize = this.bucketStart.length - 1;
+        const mask = tableSize - 1;
+        
+        this.bucketStart.fill(0);
+        for (let i = 0; i < n; i++) {
+            let l = 0;
+            const diameter = 2 * radii[i];
+            while (this.levelCellSize[l] < diameter) l++;
+            
+            const cellSize = this.levelCellSize[l];
+            const hash = MultiLevelGrid.hashCell(Math.floor(xs[i] / cellSize), Math.floor(ys[i] / cellSize), l) & mask;
+            
+            this.x[i] = xs[i];
+            this.y[i] = ys[i];
+            this.level[i] = l;
+            this.bucketOfEntry[i] = hash;
+            this.bucketStart[hash + 1]++;
+            occupied[l] = 1;
+        }
+        
+        // Counting sort entries by bucket
+        for (let b = 0; b < tableSize; b++) {
+            this.bucketStart[b + 1] += this.bucketStart[b];
+        }
+        const fill = this.bucketStart.slice(0, tableSize);
+        for (let i = 0; i < n; i++) {
+            this.bucketEntries[fill[this.bucketOfEntry[i]]++] = i;
+        }
+        
+        this.occupiedLevels.length = 0;
+        for (let l = 0; l < this.levelCount; l++) {
+            if (occupied[l]) this.occupiedLevels.push(l);
+        }
+        
+        this.stats.levels = this.occupiedLevels.length;
+        this.stats.buildTime = performance.now() - startTime;
+    }
+
+    /**
+     * Report every pair that may overlap exactly once, as callback(i, j).
+     * Same-level pairs are found from both sides and kept once by index order;
+     * cross-level pairs are only looked up from the finer entry.
+     * Passing a range [first, last) visits only the pairs found from those entries, so
+     * a long sweep can be split into slices that together report every pair once.
+     */
+    forEachCandidatePair(callback, first = 0, last = this.count) {
+        const mask = this.bucketStart.length - 2;
+        const visited = new Int32Array(9);
+        let candidatePairs = 0;
+        
+        for (let i = first; i < last; i++) {
+            const ownLevel = this.level[i];
+            
+            for (let k = 0; k < this.occupiedLevels.length; k++) {
+                const l = this.occupiedLevels[k];
+                if (l < ownLevel) continue;
+                
+                const cellSize = this.levelCellSize[l];
+                const cellX = Math.floor(this.x[i] / cellSize);
+                const cellY = Math.floor(this.y[i] / cellSize);
+                let visitedCount = 0;
+                
+                for (let ox = -1; ox <= 1; ox++) {
+                    for (let oy = -1; oy <= 1; oy++) {
+                        const hash = MultiLevelGrid.hashCell(cellX + ox, cellY + oy, l) & mask;
+                        
+                        // Distinct cells can share a bucket; scan each bucket once
+                        let seen = false;
+                        for (let v = 0; v < visitedCount; v++) {
+                            if (visited[v] === hash) {
+                                seen = true;
+                                break;
+                            }
+                        }
+                        if (seen) continue;
+                        visited[visitedCount++] = hash;
+                        
+                        for (let e = this.bucketStart[hash]; e < this.bucketStart[hash + 1]; e++) {
+                            const j = this.bucketEntries[e];
+                            if (this.level[j] !== l) continue;
+                            if (l === ownLevel && j <= i) continue;
+                            
+                            candidatePairs++;
+                            callback(i, j);
+                        }
+                    }
+                }
+            }
+        }
+        
+        this.stats.candidatePairs = first === 0 ? candidatePairs : this.stats.candidatePairs + candidatePairs;
+    }
+
+    ensureCapacity(n) {
+        if (this.x.length < n) {
+            const capacity = Math.max(n, this.x.length * 2, 16);
+            this.x = new Float64Array(capacity);
+            this.y = new Float64Array(capacity);
+            this.level = new Int32Array(capacity);
+            this.bucketOfEntry = new Int32Array(capacity);
+            this.bucketEntries = new Int32Array(capacity);
+        }
+        
+        // Power-of-two hash table with roughly two buckets per entry
+        let tableSize = 16;
+        while (tableSize < n * 2) tableSize *= 2;
+        if (this.bucketStart.length !== tableSize + 1) {
+            this.bucketStart = new Int32Array(tableSize + 1);
+        }
+    }
+
+    static hashCell(cellX, cellY, level) {
+        return Math.imul(cellX, 73856093) ^ Math.imul(cellY, 19349663) ^ Math.imul(level + 1, 83492791);
+    }
+
+    getStats() {
+        return { ...this.stats, entries: this.count };
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { MultiLevelGrid };
+}
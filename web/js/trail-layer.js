@@ -0,0 +1,296 @@
+/**
+ * Accumulation-buffer trails
+ * Instead of stroking every body's whole trail each frame, trails are painted into a
+ * persistent offscreen layer: each frame the layer is faded by a fixed alpha and only
+ * the segment each body moved since the previous frame is drawn, so the cost is O(N)
+ * per frame whatever the trail length. The layer is in screen space:
+ *   - a pan shifts its pixels and a zoom rescales them, so trails stay visible while
+ *     the camera eases; once the zoom has settled the layer is redrawn sharp from the
+ *     bodies' trail history in a few opacity bands,
+ *   - a resize or render scale change clears it and redraws it the same way.
+ */
+
+class TrailLayer {
+    constructor() {
+        this.canvas = null;
+        this.ctx = null;
+        this.fadeAlpha = RENDERING_CONSTANTS.TRAIL_FADE_ALPHA;
+        
+        // View the layer contents were drawn for (display pixels, render scale)
+        this.view = { x: 0, y: 0, zoom: 0, width: 0, height: 0, scale: 0 };
+        this.rebuildPending = false;
+        
+        this.anchors = new Map(); // Body -> { x, y, frame }: where its trail was last drawn to
+        this.frame = 0;
+        this.segments = new Map(); // Stroke style -> flat [x0, y0, x1, y1, ...], reused every frame
+        this.colorCache = new Map();
+        
+        this.stats = {
+            segments: 0,
+            rebuilds: 0,
+            updateTime: 0
+        };
+    }
+
+    /**
+     * Bring the layer up to date for this frame. camera is { x, y, zoom }; width and
+     * height are the display size in pixels and scale the scene render scale.
+     */
+    update(bodies, camera, width, height, scale, lineWidth) {
+        const startTime = performance.now();
+        const pixelWidth = Math.max(1, Math.round(width * scale));
+        const pixelHeight = Math.max(1, Math.round(height * scale));
+        if (!this.canvas) {
+            this.canvas = document.createElement('canvas');
+            this.ctx = this.canvas.getContext('2d');
+        }
+        
+        const view = this.view;
+        const ctx = this.ctx;
+        let cleared = false;
+        if (this.canvas.width !== pixelWidth || this.canvas.height !== pixelHeight) {
+            this.canvas.width = pixelWidth;
+            this.canvas.height = pixelHeight;
+            cleared = true;
+        }
+        
+        const zooming = view.zoom !== camera.zoom;
+        if (cleared || view.zoom === 0 || view.scale !== scale ||
+            view.width !== width || view.height !== height) {
+            cleared = true;
+        } else if (zooming || view.x !== camera.x || view.y !== camera.y) {
+            // Pan or zoom: move the painted pixels with the world. A screen point scales by
+            // zoom ratio k about the view centre and shifts with the camera.
+            const k = camera.zoom / view.zoom;
+            ctx.setTransform(1, 0, 0, 1, 0, 0);
+            ctx.globalCompositeOperation = 'copy';
+            ctx.drawImage(this.canvas,
+                (width / 2 * (1 - k) + (view.x - camera.x) * camera.zoom) * scale,
+                (height / 2 * (1 - k) + (view.y - camera.y) * camera.zoom) * scale,
+                this.canvas.width * k,
+                this.canvas.height * k);
+            ctx.globalCompositeOperation = 'source-over';
+            // Rescaled pixels blur and a zoom out leaves the edges empty
+            if (zooming) this.rebuildPending = true;
+        }
+        
+        view.x = camera.x;
+        view.y = camera.y;
+        view.zoom = camera.zoom;
+        view.width = width;
+        view.height = height;
+        view.scale = scale;
+        this.frame++;
+        
+        if (cleared) {
+            this.clear();
+            this.rebuildPending = true;
+        } else if (this.rebuildPending && !zooming) {
+            this.rebuild(bodies, camera, width, height, scale, lineWidth);
+        } else {
+            this.fade();
+            this.drawNewestSegments(bodies, camera, width, height, scale, lineWidth);
+        }
+        
+        this.pruneAnchors();
+        this.stats.updateTime = performance.now() - startTime;
+        return this.canvas;
+    }
+
+    clear() {
+        if (this.ctx) {
+            this.ctx.setTransform(1, 0, 0, 1, 0, 0);
+            this.ctx.clearRect(0, 0, this.canvas.width, this.canvas.height);
+        }
+        this.anchors.clear();
+    }
+
+    // Forget the contents (e.g. after trails were hidden) and redraw them from history
+    reset() {
+        this.clear();
+        this.rebuildPending = true;
+    }
+
+    fade() {
+        const ctx = this.ctx;
+        ctx.setTransform(1, 0, 0, 1, 0, 0);
+        ctx.globalCompositeOperation = 'destination-out';
+        ctx.fillStyle = `rgba(0, 0, 0, ${this.fadeAlpha})`;
+        ctx.fillRect(0, 0, this.canvas.width, this.canvas.height);
+        ctx.globalCompositeOperation = 'source-over';
+    }
+
+    // World-to-layer transform: display pixels scaled down to the layer's resolution
+    applyWorldTransform(camera, width, height, scale) {
+        const factor = camera.zoom * scale;
+        this.ctx.setTransform(factor, 0, 0, factor,
+            scale * (width / 2 - camera.x * camera.zoom),
+            scale * (height / 2 - camera.y * camera.zoom));
+    }
+
+    // One segment per body, from where its trail was last drawn to where it is now,
+    // batched into a single path per colour
+    drawNewestSegments(bodies, camera, width, height, scale, lineWidth) {
+        const frame = this.frame;
+        for (const segments of this.segments.values()) {
+            segments.length = 0;
+        }
+        
+        let segmentCount = 0;
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body.maxTrailLength <= 0) continue;
+            
+            const x = body.position.x;
+            const y = body.position.y;
+            const anchor = this.anchors.get(body);
+            if (!anchor) {
+                this.anchors.set(body, { x, y, frame });
+                continue;
+            }
+            
+            if (anchor.x !== x || anchor.y !== y) {
+                const style = this.getStrokeStyle(body.color);
+                let segments = this.segments.get(style);
+                if (!segments) {
+                    segments = [];
+                    this.segments.set(style, segments);
+                }
+                segments.push(anchor.x, anchor.y, x, y);
+                segmentCount++;
+                anchor.x = x;
+                anchor.y = y;
+            }
+            anchor.frame = frame;
+        }
+        
+        const ctx = this.ctx;
+        this.applyWorldTransform(camera, width, height, scale);
+        ctx.lineWidth = lineWidth;
+        ctx.lineCap = 'round';
+        for (const [style, segments] of this.segments) {
+            if (segments.length === 0) continue;
+            ctx.strokeStyle = style;
+            ctx.beginPath();
+            for (let k = 0; k < segments.length; k += 4) {
+                ctx.moveTo(segments[k], segments[k + 1]);
+                ctx.lineTo(segments[k + 2], segments[k + 3]);
+            }
+            ctx.stroke();
+        }
+        this.stats.segments = segmentCount;
+    }
+
+    /**
+     * Redraw the layer from the bodies' trail history, oldest band first, each band at
+     * the opacity the fade would have left its middle point with.
+     */
+    rebuild(bodies, camera, width, height, scale, lineWidth) {
+        this.clear();
+        this.rebuildPending = false;
+        this.stats.rebuilds++;
+        
+        // Points young enough to show through the fading, within a budget for the whole
+        // redraw so a large run does not stall on it
+        const fadeHorizon = Math.ceil(Math.log(1 / 255) / Math.log(1 - this.fadeAlpha));
+        const budget = Math.floor(RENDERING_CONSTANTS.TRAIL_REBUILD_MAX_POINTS / Math.max(1, bodies.length));
+        const horizon = Math.max(RENDERING_CONSTANTS.TRAIL_REBUILD_BANDS, Math.min(fadeHorizon, budget));
+        const bands = RENDERING_CONSTANTS.TRAIL_REBUILD_BANDS;
+        const bandLength = Math.ceil(horizon / bands);
+        // Bodies grouped by stroke style, so each band is one path per colour
+        const byStyle = new Map();
+        for (let i = 0; i < bodies.length; i++) {
+            const body = bodies[i];
+            if (body.maxTrailLength <= 0 || body.trail.length === 0) continue;
+            const style = this.getStrokeStyle(body.color);
+            let group = byStyle.get(style);
+            if (!group) {
+                group = [];
+                byStyle.set(style, group);
+            }
+            group.push(body);
+        }
+        
+        const ctx = this.ctx;
+        this.applyWorldTransform(camera, width, height, scale);
+        ctx.lineWidth = lineWidth;
+        ctx.lineCap = 'round';
+        
+        for (let band = bands - 1; band >= 0; band--) {
+            ctx.globalAlpha = Math.pow(1 - this.fadeAlpha, (band + 0.5) * bandLength);
+            for (const [style, group] of byStyle) {
+                ctx.strokeStyle = style;
+                ctx.beginPath();
+                for (const body of group) {
+                    // Ages count back from the body's current position
+                    const length = body.trail.length;
+                    const end = length - band * bandLength;
+                    if (end < 1) continue;
+                    const start = Math.max(0, end - bandLength);
+                    
+                    let point = body.trailPoint(start);
+                    ctx.moveTo(point.x, point.y);
+                    for (let k = start + 1; k < end; k++) {
+                        point = body.trailPoint(k);
+                        ctx.lineTo(point.x, point.y);
+                    }
+                    point = end < length ? body.trailPoint(end) : body.position;
+                    ctx.lineTo(point.x, point.y);
+                }
+                ctx.stroke();
+            }
+        }
+        ctx.globalAlpha = 1;
+        
+        for (let i = 0; i < bodies.length; i++) {
+            this.anchors.set(bodies[i], { x: bodies[i].position.x, y: bodies[i].position.y, frame: this.frame });
+        }
+    }
+
+    // Same colour and opacity as polyline trails
+    getStrokeStyle(color) {
+        let style = this.colorCache.get(color);
+        if (style === undefined) {
+            const result = /^#?([a-f\d]{2})([a-f\d]{2})([a-f\d]{2})$/i.exec(color);
+            style = result ?
+                `rgba(${parseInt(result[1], 16)}, ${parseInt(result[2], 16)}, ${parseInt(result[3], 16)}, 0.6)` :
+                'rgba(255, 255, 255, 0.6)';
+            this.colorCache.set(color, style);
+        }
+        return style;
+    }
+
+    // Bodies that have left the simulation stop being stamped; drop them now and then
+    pruneAnchors() {
+        if (this.frame % 300 !== 0) return;
+        for (const [body, anchor] of this.anchors) {
+            if (anchor.frame < this.frame - 1) {
+                this.anchors.delete(body);
+            }
+        }
+    }
+
+    getStats() {
+        return { ...this.stats };
+    }
+
+    // Layer pixels (4 bytes each) plus the per-body anchors and reused segment lists
+    getMemoryUsage() {
+        let bytes = this.canvas ? this.canvas.width * this.canvas.height * 4 : 0;
+        this.segments.forEach(segment => { bytes += segment.length * 8; });
+        const objects = this.anchors.size + this.segments.size; // The colour cache counts as a render cache
+        return { bytes: bytes + objects * RENDERING_CONSTANTS.MEMORY_OBJECT_BYTES, objects };
+    }
+
+    destroy() {
+        this.canvas = null;
+        this.ctx = null;
+        this.anchors.clear();
+        this.segments.clear();
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { TrailLayer };
+}
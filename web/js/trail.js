@@ -0,0 +1,163 @@
+/**
+ * Tiered trail history
+ * Keeps a long, shape-preserving record of a body's path in a small fixed budget.
+ * Points that age out of the body's full-resolution trail enter the first tier, and
+ * each tier in turn passes its oldest points to the next, so history runs from fine to
+ * coarse as it gets older. Every tier decimates its input incrementally with an
+ * opening-window (Douglas-Peucker-style) test: a run of points is replaced by the
+ * segment between its ends while every point in it stays within the tier's tolerance
+ * of that segment. Tolerances are relative to the segment length, so the shape is kept
+ * at any scale, and grow from tier to tier.
+ */
+
+class TieredTrail {
+    constructor(tierCount = RENDERING_CONSTANTS.TRAIL_HISTORY_TIERS,
+                tierCapacity = RENDERING_CONSTANTS.TRAIL_HISTORY_TIER_POINTS) {
+        const window = RENDERING_CONSTANTS.TRAIL_HISTORY_WINDOW;
+        this.tiers = [];
+        let tolerance = RENDERING_CONSTANTS.TRAIL_HISTORY_TOLERANCE;
+        for (let t = 0; t < tierCount; t++) {
+            this.tiers.push({
+                tolerance,
+                // Kept points, a ring with the oldest at start
+                x: new Float64Array(tierCapacity),
+                y: new Float64Array(tierCapacity),
+                start: 0,
+                count: 0,
+                // Decimator state: the last kept point and the undecided points since
+                anchorX: 0,
+                anchorY: 0,
+                hasAnchor: false,
+                pendingX: new Float64Array(window),
+                pendingY: new Float64Array(window),
+                pendingCount: 0
+            });
+            tolerance *= RENDERING_CONSTANTS.TRAIL_HISTORY_TOLERANCE_GROWTH;
+        }
+    }
+
+    /**
+     * Add the point that just left the full-resolution trail
+     */
+    push(x, y) {
+        this.feed(0, x, y);
+    }
+
+    feed(t, x, y) {
+        const tier = this.tiers[t];
+        if (!tier.hasAnchor) {
+            this.keep(t, x, y);
+            return;
+        }
+        
+        // Can the segment from the anchor to the new point still stand in for every
+        // pending point? If not, the newest pending point is kept and starts a new run.
+        const count = tier.pendingCount;
+        if (count > 0) {
+            let fits = count < tier.pendingX.length;
+            const dx = x - tier.anchorX;
+            const dy = y - tier.anchorY;
+            const length = Math.sqrt(dx * dx + dy * dy);
+            const limit = tier.tolerance * length;
+            for (let i = 0; fits && i < count; i++) {
+                const px = tier.pendingX[i] - tier.anchorX;
+                const py = tier.pendingY[i] - tier.anchorY;
+                const deviation = length > 0 ? Math.abs(px * dy - py * dx) / length : Math.sqrt(px * px + py * py);
+                // Points behind either end are not covered by the segment at all
+                const along = px * dx + py * dy;
+                fits = deviation <= limit && along >= 0 && along <= length * length;
+            }
+            if (!fits) {
+                this.keep(t, tier.pendingX[count - 1], tier.pendingY[count - 1]);
+            }
+        }
+        
+        tier.pendingX[tier.pendingCount] = x;
+        tier.pendingY[tier.pendingCount] = y;
+        tier.pendingCount++;
+    }
+
+    // Store a decided point; a full tier hands its oldest point on to the next tier
+    keep(t, x, y) {
+        const tier = this.tiers[t];
+        const capacity = tier.x.length;
+        tier.anchorX = x;
+        tier.anchorY = y;
+        tier.hasAnchor = true;
+        tier.pendingCount = 0;
+        
+        if (tier.count === capacity) {
+            const oldestX = tier.x[tier.start];
+            const oldestY = tier.y[tier.start];
+            tier.start = (tier.start + 1) % capacity;
+            tier.count--;
+            if (t + 1 < this.tiers.length) {
+                this.feed(t + 1, oldestX, oldestY);
+            }
+        }
+        
+        const index = (tier.start + tier.count) % capacity;
+        tier.x[index] = x;
+        tier.y[index] = y;
+        tier.count++;
+    }
+
+    /**
+     * Visit the history from oldest to newest: each tier's kept points followed by its
+     * undecided ones, coarsest tier first. The last point visited is the one that most
+     * recently left the full-resolution trail.
+     */
+    forEachPoint(callback) {
+        for (let t = this.tiers.length - 1; t >= 0; t--) {
+            const tier = this.tiers[t];
+            const capacity = tier.x.length;
+            for (let i = 0; i < tier.count; i++) {
+                const index = (tier.start + i) % capacity;
+                callback(tier.x[index], tier.y[index]);
+            }
+            for (let i = 0; i < tier.pendingCount; i++) {
+                callback(tier.pendingX[i], tier.pendingY[i]);
+            }
+        }
+    }
+
+    // Drop the coarsest tier (budget shedding); the finest tier is always kept
+    dropOldestTier() {
+        if (this.tiers.length <= 1) return false;
+        this.tiers.pop();
+        return true;
+    }
+
+    getByteLength() {
+        let bytes = 0;
+        for (const tier of this.tiers) {
+            bytes += tier.x.byteLength + tier.y.byteLength + tier.pendingX.byteLength + tier.pendingY.byteLength;
+        }
+        return bytes;
+    }
+
+    getPointCount() {
+        let count = 0;
+        for (const tier of this.tiers) {
+            count += tier.count + tier.pendingCount;
+        }
+        return count;
+    }
+
+    clone() {
+        const copy = new TieredTrail(this.tiers.length, this.tiers.length > 0 ? this.tiers[0].x.length : 0);
+        copy.tiers = this.tiers.map(tier => ({
+            ...tier,
+            x: tier.x.slice(),
+            y: tier.y.slice(),
+            pendingX: tier.pendingX.slice(),
+            pendingY: tier.pendingY.slice()
+        }));
+        return copy;
+    }
+}
+
+// Export for use in other modules
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = { TieredTrail };
+}
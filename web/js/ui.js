@@ -9,6 +9,7 @@ class UIManager {
         this.referenceShown = false; // Reference panel state
         this.performanceShown = false; // Performance panel state
         this.energyShown = false; // Energy panel state
+        this.orbitSurveyShown = null; // Survey and selected body the orbit panel last showed
         this.renderer = null; // Will be set by app
         this.tooltipElement = null;
         
@@ -131,7 +132,8 @@ class UIManager {
             'play-pause', 'reset', 'clear', 'zoom-in', 'zoom-out',
             'center-view', 'fit-view', 'save-config', 'load-config',
             'export-video', 'delete-selected', 'help-btn', 'show-shortcuts',
-            'debug-mode', 'performance-mode'
+            'debug-mode', 'performance-mode', 'download-flight-recording',
+            'run-benchmark', 'download-benchmark-json', 'download-benchmark-html'
         ];
 
         buttonIds.forEach(id => {
@@ -225,8 +227,8 @@ class UIManager {
 
     initializeCheckboxes() {
         const checkboxIds = [
-            'collision-enabled', 'show-trails', 'show-grid', 'show-forces', 'long-term-preview',
-            'show-collision-bounds', 'adaptive-timestep', 'web-workers'
+            'collision-enabled', 'show-trails', 'accumulated-trails', 'trail-history', 'show-grid', 'show-forces', 'long-term-preview',
+            'show-collision-bounds', 'adaptive-timestep', 'multiple-time-stepping', 'escaper-archival', 'cost-overlay', 'memory-budgets', 'group-finder', 'orbit-survey', 'web-workers'
         ];
 
         checkboxIds.forEach(id => {
@@ -510,6 +512,40 @@ class UIManager {
                 this.onRenderingSettingChange('level-of-detail', e.target.checked);
             });
         }
+        
+        // Dynamic resolution checkbox and render scale bounds
+        const dynamicResolution = document.getElementById('dynamic-resolution');
+        if (dynamicResolution) {
+            dynamicResolution.addEventListener('change', (e) => {
+                this.onRenderingSettingChange('dynamic-resolution', e.target.checked);
+            });
+        }
+        
+        const renderScaleMin = document.getElementById('render-scale-min');
+        const renderScaleMax = document.getElementById('render-scale-max');
+        const renderScaleMinValue = document.getElementById('render-scale-min-value');
+        const renderScaleMaxValue = document.getElementById('render-scale-max-value');
+        if (renderScaleMin && renderScaleMax) {
+            const updateRenderScaleBounds = (changed) => {
+                let min = parseFloat(renderScaleMin.value);
+                let max = parseFloat(renderScaleMax.value);
+                // Keep the pair ordered by moving whichever slider was not touched
+                if (min > max) {
+                    if (changed === renderScaleMin) {
+                        renderScaleMax.value = min;
+                        max = min;
+                    } else {
+                        renderScaleMin.value = max;
+                        min = max;
+                    }
+                }
+                if (renderScaleMinValue) renderScaleMinValue.textContent = min.toFixed(2);
+                if (renderScaleMaxValue) renderScaleMaxValue.textContent = max.toFixed(2);
+                this.onRenderingSettingChange('render-scale-bounds', { min, max });
+            };
+            renderScaleMin.addEventListener('input', () => updateRenderScaleBounds(renderScaleMin));
+            renderScaleMax.addEventListener('input', () => updateRenderScaleBounds(renderScaleMax));
+        }
     }
 
     // Panel toggle methods
@@ -642,6 +678,19 @@ class UIManager {
             elements.integrationTimeElement.textContent = formatTime(stats.integrationTime);
         }
         
+        if (stats.diagnostics) {
+            this.updateDiagnostics(stats.diagnostics);
+        }
+        if (stats.flightRecorder) {
+            this.updateFlightRecorder(stats.flightRecorder);
+        }
+        if (stats.costProfile !== undefined) {
+            this.updateCostProfile(stats.costProfile);
+        }
+        if (stats.memory) {
+            this.updateMemoryLedger(stats.memory);
+        }
+        
         // Update GPU status if available
         if (stats.gpu && typeof stats.gpu === 'object' && stats.gpu.isSupported) {
             const gpuModeElement = this.getElement('gpu-mode');
@@ -657,6 +706,359 @@ class UIManager {
         }
     }
 
+    // Render the once-per-second diagnostics report in the performance tab
+    updateDiagnostics(report) {
+        const container = this.getElement('diagnostics-list');
+        if (!container || !Array.isArray(report.categories)) return;
+        
+        container.innerHTML = '';
+        
+        if (report.categories.length === 0) {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            row.innerHTML = '<span class="resource-label">No issues recorded</span>';
+            container.appendChild(row);
+            return;
+        }
+        
+        report.categories.forEach(category => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            if (category.sample) {
+                row.title = `First seen: ${category.sample}`;
+            }
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = category.label;
+            
+            const value = document.createElement('span');
+            value.className = 'resource-value';
+            value.textContent = `${Math.round(category.perSecond)}/s (${category.total} total)`;
+            
+            row.appendChild(label);
+            row.appendChild(value);
+            container.appendChild(row);
+        });
+    }
+
+    // Frames held by the flight recorder and the stalls it has seen
+    updateFlightRecorder(stats) {
+        const container = this.getElement('flight-recorder-list');
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText) => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            
+            const value = document.createElement('span');
+            value.className = 'resource-value';
+            value.textContent = valueText;
+            
+            row.appendChild(label);
+            row.appendChild(value);
+            container.appendChild(row);
+        };
+        
+        addRow('Frames recorded', `${stats.frames}`);
+        addRow('Stalls', `${stats.stalls} (${stats.captures} captured)`);
+        if (stats.lastStall) {
+            addRow('Last stall', `${stats.lastStall.interval.toFixed(0)} ms`);
+        }
+        addRow('Long tasks', stats.longTasks === null ? 'Not supported' : `${stats.longTasks}`);
+    }
+
+    // Bytes per subsystem against its budget, with the growth rate over the last few minutes
+    updateMemoryLedger(stats) {
+        const format = MemoryLedger.formatBytes;
+        const usageElement = this.getElement('memory-usage');
+        if (usageElement) {
+            usageElement.textContent = stats.heap !== null
+                ? `${format(stats.bytes)} of ${format(stats.heap)} heap`
+                : format(stats.bytes);
+        }
+        
+        const container = this.getElement('memory-list');
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText, title = '') => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            if (title) row.title = title;
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            
+            const value = document.createElement('span');
+            value.className = 'resource-value';
+            value.textContent = valueText;
+            
+            row.appendChild(label);
+            row.appendChild(value);
+            container.appendChild(row);
+        };
+        
+        stats.entries.forEach(entry => {
+            let value = format(entry.bytes);
+            if (isFinite(entry.budget)) value += ` / ${format(entry.budget)}`;
+            if (Math.abs(entry.growth) >= 1024) value += ` (${entry.growth > 0 ? '+' : ''}${format(entry.growth)}/min)`;
+            if (entry.exhausted) value += ' !';
+            
+            const title = `${entry.objects} objects, peak ${format(entry.peak)}` +
+                (entry.sheds > 0 ? `, shed ${entry.sheds} times` : '') +
+                (entry.exhausted ? ', over budget with nothing left to shed' : '');
+            addRow(entry.label, value, title);
+        });
+        addRow('Total', format(stats.bytes));
+    }
+
+    // Distribution of per-body interaction counts from the last profiled step
+    updateCostProfile(histogram) {
+        this.drawHistogram('cost-histogram', histogram, 'log2 cost');
+        
+        const container = this.getElement('cost-list');
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText) => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            row.appendChild(label);
+            
+            if (valueText !== undefined) {
+                const value = document.createElement('span');
+                value.className = 'resource-value';
+                value.textContent = valueText;
+                row.appendChild(value);
+            }
+            container.appendChild(row);
+        };
+        
+        if (!histogram) {
+            addRow('Cost profiling off');
+            return;
+        }
+        if (histogram.bodies === 0) {
+            addRow('No step profiled yet');
+            return;
+        }
+        
+        const perBody = value => (value / histogram.bodies).toFixed(1);
+        addRow('Tree cells / body', perBody(histogram.cells));
+        addRow('Direct pairs / body', perBody(histogram.direct));
+        addRow('Collision pairs / body', perBody(histogram.collisions));
+        addRow('Costliest body', `${histogram.maxCost}`);
+    }
+
+    // Benchmark progress, or a summary of the last report
+    updateBenchmark(status) {
+        const container = this.getElement('benchmark-list');
+        const runButton = this.getElement('run-benchmark');
+        if (runButton) {
+            const label = runButton.querySelector('span');
+            if (label) label.textContent = status.active ? 'Cancel Benchmark' : 'Run Benchmark';
+        }
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText) => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            row.appendChild(label);
+            
+            if (valueText !== undefined) {
+                const value = document.createElement('span');
+                value.className = 'resource-value';
+                value.textContent = valueText;
+                row.appendChild(value);
+            }
+            container.appendChild(row);
+        };
+        
+        if (status.active && status.run) {
+            const run = status.run;
+            addRow('Run', `${status.runNumber} / ${status.runCount}`);
+            addRow('Scene', `${run.scene}, ${run.bodyCount} bodies`);
+            addRow('Settings', `${run.renderer}, ${run.forceMethod}, worker ${run.workers ? 'on' : 'off'}`);
+            return;
+        }
+        
+        const report = status.report;
+        if (!report) {
+            addRow('Not run yet');
+            return;
+        }
+        
+        addRow(report.cancelled ? 'Cancelled' : 'Finished', `${report.runs.length} runs`);
+        const truncated = report.runs.filter(run => run.truncated).length;
+        if (truncated > 0) {
+            addRow('Hit time limit', `${truncated} runs`);
+        }
+        // Median frame rate of the largest scene each force method finished
+        ['naive', 'barnes-hut'].forEach(method => {
+            const runs = report.runs.filter(run => run.forceMethod === method && !run.truncated);
+            if (runs.length === 0) return;
+            const largest = runs.reduce((best, run) => run.bodyCount > best.bodyCount ? run : best);
+            addRow(`${method} at ${largest.bodyCount}`, `${largest.fps.p50.toFixed(0)} FPS`);
+        });
+    }
+
+    // Summarise the latest group catalog: totals, the heaviest groups and the last event
+    updateGroupCatalog(catalog, enabled = true) {
+        const container = this.getElement('group-list');
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText) => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            row.appendChild(label);
+            
+            if (valueText !== undefined) {
+                const value = document.createElement('span');
+                value.className = 'resource-value';
+                value.textContent = valueText;
+                row.appendChild(value);
+            }
+            container.appendChild(row);
+        };
+        
+        const stats = catalog.getStats();
+        if (!enabled) {
+            addRow('Group finder off');
+            return;
+        }
+        if (stats.catalogs === 0 || catalog.bodyCount === 0) {
+            addRow('No catalog yet');
+            return;
+        }
+        
+        addRow('Groups', `${stats.groups} (${(stats.groupedFraction * 100).toFixed(0)}% of bodies)`);
+        catalog.groups.slice(0, 5).forEach(group => {
+            addRow(`#${group.id}`, `${group.members} bodies, mass ${group.mass.toFixed(0)}, r½ ${group.halfMassRadius.toFixed(0)}`);
+        });
+        
+        const event = catalog.events[catalog.events.length - 1];
+        if (event) {
+            const detail = event.type === 'merged' ? ` from #${event.progenitors.join(', #')}` : '';
+            addRow(`Last event: #${event.groupId} ${event.type}${detail}`);
+        }
+    }
+
+    // Orbit survey panel: bound fraction, the selected body's elements and a histogram
+    // of period ratios to the reference body (semi-major axes when there is none)
+    updateOrbitSurvey(survey, enabled = true, selectedBody = null) {
+        const shown = this.orbitSurveyShown;
+        if (shown && shown.survey === survey && shown.enabled === enabled && shown.body === selectedBody) return;
+        this.orbitSurveyShown = { survey, enabled, body: selectedBody };
+        
+        const container = this.getElement('orbit-list');
+        if (!container) return;
+        
+        container.innerHTML = '';
+        const addRow = (labelText, valueText) => {
+            const row = document.createElement('div');
+            row.className = 'resource-row';
+            
+            const label = document.createElement('span');
+            label.className = 'resource-label';
+            label.textContent = labelText;
+            row.appendChild(label);
+            
+            if (valueText !== undefined) {
+                const value = document.createElement('span');
+                value.className = 'resource-value';
+                value.textContent = valueText;
+                row.appendChild(value);
+            }
+            container.appendChild(row);
+        };
+        
+        const histogram = survey ? (survey.histograms.periodRatio || survey.histograms.semiMajorAxis) : null;
+        this.drawHistogram('orbit-histogram', histogram, survey && survey.histograms.periodRatio ? 'P / P ref' : 'a');
+        
+        if (!enabled) {
+            addRow('Orbit survey off');
+            return;
+        }
+        if (!survey) {
+            addRow('No survey yet');
+            return;
+        }
+        
+        const n = survey.ids.length;
+        addRow('Bound', `${survey.boundCount} of ${n} (${(survey.boundCount / n * 100).toFixed(0)}%)`);
+        if (survey.reference >= 0) {
+            addRow('Reference', `body ${survey.ids[survey.reference]}, P ${survey.period[survey.reference].toFixed(1)}`);
+        }
+        
+        const index = selectedBody ? survey.ids.indexOf(selectedBody.id) : -1;
+        if (index < 0) {
+            addRow('Select a body for its elements');
+            return;
+        }
+        if (survey.attractor[index] < 0) {
+            addRow('Selected', 'no heavier attractor');
+            return;
+        }
+        
+        addRow('Orbits', `body ${survey.ids[survey.attractor[index]]}`);
+        if (survey.bound[index]) {
+            addRow('a / e', `${survey.semiMajorAxis[index].toFixed(1)} / ${survey.eccentricity[index].toFixed(3)}`);
+            addRow('Period', survey.period[index].toFixed(2));
+        } else {
+            addRow('Unbound', `e ${survey.eccentricity[index].toFixed(3)}`);
+        }
+    }
+
+    drawHistogram(canvasId, histogram, axisLabel) {
+        const canvas = this.getElement(canvasId);
+        if (!canvas) return;
+        const ctx = canvas.getContext('2d');
+        const width = canvas.width;
+        const height = canvas.height;
+        
+        ctx.clearRect(0, 0, width, height);
+        if (!histogram) return;
+        
+        const counts = histogram.counts;
+        let peak = 0;
+        for (let i = 0; i < counts.length; i++) {
+            peak = Math.max(peak, counts[i]);
+        }
+        if (peak === 0) return;
+        
+        const barWidth = width / counts.length;
+        ctx.fillStyle = '#64ffda';
+        for (let i = 0; i < counts.length; i++) {
+            const barHeight = counts[i] / peak * (height - 12);
+            ctx.fillRect(i * barWidth, height - barHeight, Math.max(1, barWidth - 1), barHeight);
+        }
+        
+        ctx.font = '10px Inter';
+        ctx.fillStyle = 'rgba(255, 255, 255, 0.7)';
+        ctx.fillText(`${axisLabel} ${histogram.min.toFixed(1)} – ${histogram.max.toFixed(1)}`, 4, 10);
+    }
+
     updateEnergyDisplay(energy) {
         const kineticDisplay = document.getElementById('energy-kinetic');
         const potentialDisplay = document.getElementById('energy-potential');
@@ -1598,6 +2000,12 @@ class UIManager {
             renderTime.textContent = `${stats.renderTime.toFixed(2)}ms`;
         }
         
+        // Update render scale
+        const renderScale = document.getElementById('render-scale');
+        if (renderScale && stats.renderScale !== undefined) {
+            renderScale.textContent = `${Math.round(stats.renderScale * 100)}%`;
+        }
+        
         // Update FPS in header
         const fpsDisplay = document.getElementById('fps-display');
         if (fpsDisplay && stats.fps !== undefined) {
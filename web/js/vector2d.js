@@ -37,7 +37,9 @@ class Vector2D {
 
     divide(scalar) {
         if (Math.abs(scalar) < Number.EPSILON) {
-            console.warn('Vector2D: Division by near-zero value detected, returning zero vector');
+            if (Diagnostics.counts[DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO, 'divide() returned a zero vector');
+            }
             return new Vector2D(0, 0);
         }
         return new Vector2D(this.x / scalar, this.y / scalar);
@@ -46,7 +48,9 @@ class Vector2D {
     // Mutating operations
     addMut(other) {
         if (!other || typeof other.x !== 'number' || typeof other.y !== 'number') {
-            console.warn('Vector2D: Invalid vector in addMut operation');
+            if (Diagnostics.counts[DIAGNOSTIC.VECTOR_INVALID_OPERAND]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.VECTOR_INVALID_OPERAND, 'addMut() ignored an invalid vector');
+            }
             return this;
         }
         this.x += other.x;
@@ -56,7 +60,9 @@ class Vector2D {
 
     subtractMut(other) {
         if (!other || typeof other.x !== 'number' || typeof other.y !== 'number') {
-            console.warn('Vector2D: Invalid vector in subtractMut operation');
+            if (Diagnostics.counts[DIAGNOSTIC.VECTOR_INVALID_OPERAND]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.VECTOR_INVALID_OPERAND, 'subtractMut() ignored an invalid vector');
+            }
             return this;
         }
         this.x -= other.x;
@@ -66,7 +72,9 @@ class Vector2D {
 
     multiplyMut(scalar) {
         if (typeof scalar !== 'number' || !isFinite(scalar)) {
-            console.warn('Vector2D: Invalid scalar in multiplyMut operation');
+            if (Diagnostics.counts[DIAGNOSTIC.VECTOR_INVALID_OPERAND]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.VECTOR_INVALID_OPERAND, `multiplyMut() ignored scalar ${scalar}`);
+            }
             return this;
         }
         this.x *= scalar;
@@ -76,7 +84,9 @@ class Vector2D {
 
     divideMut(scalar) {
         if (Math.abs(scalar) < Number.EPSILON) {
-            console.warn('Vector2D: Division by near-zero value in divideMut, no operation performed');
+            if (Diagnostics.counts[DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO]++ === 0) {
+                Diagnostics.sample(DIAGNOSTIC.VECTOR_DIVIDE_BY_ZERO, 'divideMut() left the vector unchanged');
+            }
             return this;
         }
         this.x /= scalar;
@@ -773,8 +773,13 @@ class WebGLRenderer {
         this.showOrbitPreview = show;
     }
 
-    setLongTermPreview(show) {
+    setLongTermPreview(show, previewData = null) {
         this.showLongTermPreview = show;
+        this.longTermPreviewPoints = show && previewData ? previewData.points || [] : [];
+    }
+
+    setGroupCatalog(groups) {
+        this.groups = groups || [];
     }
 
     setOrbitPreview(show, previewData = null) {
@@ -828,8 +833,7 @@ class WebGLRenderer {
     }
 
     calculateOrbitPreview(body, bodies, physics) {
-        // Simplified - returns empty for WebGL renderer
-        return { points: [] };
+        return OrbitPreview.calculate(body, bodies, physics);
     }
 
     calculateLongTermOrbitPreview(body, bodies, physics) {